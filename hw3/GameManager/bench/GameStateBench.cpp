@@ -0,0 +1,298 @@
+// bench/GameStateBench.cpp
+//
+// Headless benchmark for the GameState engine. Built and run by `make bench`
+// (optimised, logging compiled out, GameState profiling switched on).
+//
+// Sweeps synthetic maps over board size, tanks per side and shooting rate,
+// drives GameState directly with deterministic built-in tank algorithms, and
+// reports turns/sec, ns/turn per phase, heap allocations per turn and the
+// cost of cloning and restoring the rules state.
+//
+// Usage: gamestate_bench [games=N] [steps=N] [filter=substring] [quick]
+
+#include "GameState.h"
+#include "PhaseTimer.h"
+#include <GameManagerRegistration.h>
+#include <Player.h>
+#include <SatelliteView.h>
+#include <TankAlgorithm.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// ——————————————————————————————————————————————————————
+// Allocation counting
+// ——————————————————————————————————————————————————————
+namespace {
+std::atomic<std::uint64_t> g_allocs{0};
+
+void* countedAlloc(std::size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+} // namespace
+
+void* operator new(std::size_t n)                         { return countedAlloc(n); }
+void* operator new[](std::size_t n)                       { return countedAlloc(n); }
+void  operator delete(void* p) noexcept                   { std::free(p); }
+void  operator delete[](void* p) noexcept                 { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept      { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept    { std::free(p); }
+
+// GameManager_315634022.cpp registers itself with the simulator; the bench
+// links it but never uses the registration.
+GameManagerRegistration::GameManagerRegistration(GameManagerFactory) {}
+
+using namespace GameManager_315634022;
+
+namespace {
+
+// ——————————————————————————————————————————————————————
+// Deterministic built-in players
+// ——————————————————————————————————————————————————————
+inline std::uint64_t xorshift(std::uint64_t& s) {
+    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+    return s;
+}
+
+struct BenchBattleInfo : BattleInfo {
+    char ahead = ' ';
+};
+
+// Random walker that shoots shootPct% of the time and asks for battle info
+// now and then; it turns away from walls it has seen.
+class ScriptedTank : public TankAlgorithm {
+public:
+    ScriptedTank(int player, int tank, int shootPct)
+        : state_(0x9E3779B97F4A7C15ull ^ (std::uint64_t(player) << 32) ^ std::uint64_t(tank + 1)),
+          shootPct_(shootPct) {}
+
+    ActionRequest getAction() override {
+        const std::uint64_t r = xorshift(state_) >> 11;
+        if (r % 16 == 0) return ActionRequest::GetBattleInfo;
+        if (blocked_) { blocked_ = false; return ActionRequest::RotateRight90; }
+        if (int(r % 100) < shootPct_) return ActionRequest::Shoot;
+        switch ((r >> 8) % 6) {
+            case 0:  return ActionRequest::RotateLeft45;
+            case 1:  return ActionRequest::RotateRight45;
+            case 2:  return ActionRequest::MoveBackward;
+            default: return ActionRequest::MoveForward;
+        }
+    }
+
+    void updateBattleInfo(BattleInfo& info) override {
+        if (auto* bi = dynamic_cast<BenchBattleInfo*>(&info)) blocked_ = (bi->ahead == '#');
+    }
+
+private:
+    std::uint64_t state_;
+    int           shootPct_;
+    bool          blocked_ = false;
+};
+
+class BenchPlayer : public Player {
+public:
+    void updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& view) override {
+        // Find ourselves in a small window and report the cell to the right.
+        BenchBattleInfo info;
+        for (std::size_t y = 0; y < 8; ++y) {
+            for (std::size_t x = 0; x < 8; ++x) {
+                if (view.getObjectAt(x, y) == '%') info.ahead = view.getObjectAt(x + 1, y);
+            }
+        }
+        tank.updateBattleInfo(info);
+    }
+};
+
+// ——————————————————————————————————————————————————————
+// Synthetic maps
+// ——————————————————————————————————————————————————————
+struct MapSpec {
+    std::size_t rows, cols, tanksPerSide;
+    int         wallPct, minePct;
+};
+
+class GridView : public SatelliteView {
+public:
+    explicit GridView(const std::vector<std::string>& rows) : rows_(rows) {}
+    char getObjectAt(std::size_t x, std::size_t y) const override {
+        if (y >= rows_.size() || x >= rows_[y].size()) return ' ';
+        return rows_[y][x];
+    }
+private:
+    const std::vector<std::string>& rows_;
+};
+
+std::vector<std::string> makeMap(const MapSpec& spec, std::uint64_t seed) {
+    std::vector<std::string> g(spec.rows, std::string(spec.cols, ' '));
+    for (auto& row : g) {
+        for (auto& c : row) {
+            const int r = int(xorshift(seed) % 100);
+            if (r < spec.wallPct) c = '#';
+            else if (r < spec.wallPct + spec.minePct) c = '@';
+        }
+    }
+    // Player 1 on the left third, player 2 on the right third.
+    for (int p = 1; p <= 2; ++p) {
+        for (std::size_t t = 0; t < spec.tanksPerSide; ++t) {
+            const std::size_t band = std::max<std::size_t>(1, spec.cols / 3);
+            const std::size_t x = (p == 1 ? 0 : spec.cols - band) + xorshift(seed) % band;
+            const std::size_t y = xorshift(seed) % spec.rows;
+            g[y][x] = char('0' + p);
+        }
+    }
+    return g;
+}
+
+// ——————————————————————————————————————————————————————
+// Scenarios
+// ——————————————————————————————————————————————————————
+struct Scenario {
+    std::string name;
+    MapSpec     map;
+    int         shootPct;
+    std::size_t numShells;
+};
+
+struct Totals {
+    std::uint64_t turns = 0, ns = 0, allocs = 0, shellTurns = 0;
+    std::uint64_t clones = 0, cloneNs = 0, cloneAllocs = 0;   // cloneRules + restoreRules pairs
+    std::uint64_t phaseCycles[GameProfile::kPhaseCount] = {};
+    std::uint64_t algoCycles = 0;
+};
+
+// Clone and restore the rules state every few turns, timed apart from the turns
+constexpr std::size_t kCloneEvery = 16;
+
+void timeClone(GameState& state, RulesState& snapshot, Totals& tot) {
+    const std::uint64_t allocsBefore = g_allocs.load(std::memory_order_relaxed);
+    const auto t0 = std::chrono::steady_clock::now();
+    state.cloneRules(snapshot);
+    state.restoreRules(snapshot);
+    tot.cloneNs += std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - t0).count());
+    tot.cloneAllocs += g_allocs.load(std::memory_order_relaxed) - allocsBefore;
+    ++tot.clones;
+}
+
+Totals runScenario(const Scenario& sc, std::size_t games, std::size_t maxSteps) {
+    Totals tot;
+    GameState state;            // reused across games, as the GameArena does
+    RulesState snapshot;
+    BenchPlayer p1, p2;
+    const int shootPct = sc.shootPct;
+    TankAlgorithmFactory factory = [shootPct](int player, int tank) {
+        return std::make_unique<ScriptedTank>(player, tank, shootPct);
+    };
+
+    for (std::size_t g = 0; g < games; ++g) {
+        const auto grid = makeMap(sc.map, 0xC0FFEEull + g * 7919);
+        GridView view(grid);
+        state.reset(view, sc.map.cols, sc.map.rows, sc.name, maxSteps, sc.numShells,
+                    p1, "bench1", p2, "bench2", factory, factory, false);
+        state.setProfiling(true);
+
+        state.cloneRules(snapshot);   // size the snapshot before counting allocations
+        const std::uint64_t allocsBefore = g_allocs.load(std::memory_order_relaxed);
+        const std::uint64_t cloneNsBefore = tot.cloneNs, cloneAllocsBefore = tot.cloneAllocs;
+        const auto t0 = std::chrono::steady_clock::now();
+        while (!state.isGameOver()) {
+            state.advanceOneTurn();
+            ++tot.turns;
+            tot.shellTurns += state.getLiveShellCount();
+            if (tot.turns % kCloneEvery == 0) timeClone(state, snapshot, tot);
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        tot.allocs += g_allocs.load(std::memory_order_relaxed) - allocsBefore - (tot.cloneAllocs - cloneAllocsBefore);
+        tot.ns += std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) -
+                  (tot.cloneNs - cloneNsBefore);
+
+        const GameProfile& prof = state.getProfile();
+        for (std::size_t i = 0; i < GameProfile::kPhaseCount; ++i) tot.phaseCycles[i] += prof.phaseCycles[i];
+        tot.algoCycles += prof.algoCycles[0] + prof.algoCycles[1];
+        state.releaseBindings();
+    }
+    return tot;
+}
+
+std::vector<Scenario> buildSweep(bool quick) {
+    const std::vector<std::pair<std::size_t, std::size_t>> sizes =
+        quick ? std::vector<std::pair<std::size_t, std::size_t>>{{16, 16}, {100, 100}}
+              : std::vector<std::pair<std::size_t, std::size_t>>{{16, 16}, {64, 64}, {200, 200}, {500, 500}};
+    const std::vector<std::size_t> tanks = quick ? std::vector<std::size_t>{2, 16}
+                                                 : std::vector<std::size_t>{1, 8, 32};
+    const std::vector<int> shootPcts = {5, 40};
+
+    std::vector<Scenario> out;
+    for (auto [rows, cols] : sizes) {
+        for (auto t : tanks) {
+            if (2 * t > rows * cols / 4) continue;
+            for (int sp : shootPcts) {
+                Scenario sc;
+                sc.name = std::to_string(rows) + "x" + std::to_string(cols) +
+                          "_t" + std::to_string(t) + "_s" + std::to_string(sp);
+                sc.map = MapSpec{rows, cols, t, 8, 2};
+                sc.shootPct = sp;
+                sc.numShells = 40;
+                out.push_back(sc);
+            }
+        }
+    }
+    return out;
+}
+
+void printHeader() {
+    std::printf("%-20s %8s %11s %9s", "scenario", "turns", "turns/s", "ns/turn");
+    for (std::size_t i = 0; i < GameProfile::kPhaseCount; ++i) std::printf(" %9.9s", phaseName(Phase(i)));
+    std::printf(" %9s %8s %12s %9s\n", "algos", "shells", "allocs/turn", "clone");
+}
+
+void printRow(const Scenario& sc, const Totals& t, double cyclesPerNs) {
+    const double turns = t.turns ? double(t.turns) : 1.0;
+    const double perTurnNs = cyclesPerNs * turns;
+    std::printf("%-20s %8llu %11.0f %9.0f", sc.name.c_str(),
+                static_cast<unsigned long long>(t.turns),
+                t.ns ? double(t.turns) * 1e9 / double(t.ns) : 0.0,
+                double(t.ns) / turns);
+    for (std::size_t i = 0; i < GameProfile::kPhaseCount; ++i) std::printf(" %9.0f", double(t.phaseCycles[i]) / perTurnNs);
+    std::printf(" %9.0f %8.1f %12.3f %9.0f\n", double(t.algoCycles) / perTurnNs,
+                double(t.shellTurns) / turns, double(t.allocs) / turns,
+                t.clones ? double(t.cloneNs) / double(t.clones) : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t games = 3, steps = 1000;
+    bool quick = false;
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "quick")                 quick = true;
+        else if (arg.rfind("games=", 0) == 0)  games = std::stoul(arg.substr(6));
+        else if (arg.rfind("steps=", 0) == 0)  steps = std::stoul(arg.substr(6));
+        else if (arg.rfind("filter=", 0) == 0) filter = arg.substr(7);
+        else {
+            std::fprintf(stderr, "Usage: %s [games=N] [steps=N] [filter=substring] [quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("GameState bench: %zu game(s) per scenario, max %zu steps; phase and algos columns are ns/turn,\n"
+                "clone is ns per cloneRules + restoreRules pair; bitboard kernels: %s\n",
+                games, steps, bitkernels::name());
+    const double cyclesPerNs = UserCommon_315634022::calibrateCyclesPerNs();
+    printHeader();
+    for (const auto& sc : buildSweep(quick)) {
+        if (!filter.empty() && sc.name.find(filter) == std::string::npos) continue;
+        printRow(sc, runScenario(sc, games, steps), cyclesPerNs);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+// include/BitBoard.h
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GameManager_315634022 {
+
+/// Word kernels behind BitLayer. The instruction set is picked at compile
+/// time (make SIMD=avx2|sse2|scalar): AVX2 when the compiler targets it,
+/// else SSE2 (the x86-64 baseline), else plain 64-bit words.
+namespace bitkernels {
+std::size_t popcount(const std::uint64_t* words, std::size_t n);
+void        zero(std::uint64_t* words, std::size_t n);
+/// "avx2", "sse2" or "scalar".
+const char* name();
+} // namespace bitkernels
+
+/// One bit per board cell. Each row starts on a fresh 64-bit word (bits
+/// past the last column stay zero); whole-layer counts run the SIMD
+/// kernels over one flat buffer. Copying is a memcpy of the words.
+class BitLayer {
+public:
+    /// Resize to rows×cols and clear, keeping the allocation when it fits.
+    void reset(std::size_t rows, std::size_t cols);
+    void clear() { bitkernels::zero(words_.data(), words_.size()); }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    const std::uint64_t* row(std::size_t y) const { return words_.data() + y * wordsPerRow_; }
+
+    bool test(int x, int y) const  { return (words_[word(x, y)] >> (unsigned(x) & 63)) & 1u; }
+    void set(int x, int y)         { words_[word(x, y)] |= bit(x); }
+    void unset(int x, int y)       { words_[word(x, y)] &= ~bit(x); }
+
+    std::size_t count() const { return bitkernels::popcount(words_.data(), words_.size()); }
+
+    /// Calls f(x, y) for every set bit, row by row, left to right.
+    template <typename F>
+    void forEachSet(F&& f) const {
+        for (std::size_t y = 0; y < rows_; ++y) {
+            const std::uint64_t* r = row(y);
+            for (std::size_t w = 0; w < wordsPerRow_; ++w) {
+                for (std::uint64_t bits = r[w]; bits; bits &= bits - 1) {
+                    f(int(w * 64 + std::size_t(std::countr_zero(bits))), int(y));
+                }
+            }
+        }
+    }
+
+private:
+    std::size_t word(int x, int y) const { return std::size_t(y) * wordsPerRow_ + (unsigned(x) >> 6); }
+    static std::uint64_t bit(int x) { return std::uint64_t(1) << (unsigned(x) & 63); }
+
+    std::size_t rows_ = 0, cols_ = 0, wordsPerRow_ = 0;
+    std::vector<std::uint64_t> words_;
+};
+
+} // namespace GameManager_315634022
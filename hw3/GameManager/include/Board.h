@@ -3,13 +3,15 @@
 
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <SatelliteView.h>
+#include <BitBoard.h>
 
 namespace GameManager_315634022{
 
 
 /// Contents of a single board cell.
-enum class CellContent {
+enum class CellContent : std::uint8_t {
     EMPTY,
     WALL,
     MINE,
@@ -17,36 +19,84 @@ enum class CellContent {
     TANK2
 };
 
-/// A cell tracks its content, wall-hit count, and any shell overlay.
+/// A cell tracks its content, wall-hit count, and any shell overlay,
+/// packed into one byte. Walls fall after 2 hits, so 2 bits of count suffice.
 struct Cell {
-    CellContent content = CellContent::EMPTY;
-    int         wallHits = 0;
-    bool        hasShellOverlay = false;
+    CellContent  content : 3         = CellContent::EMPTY;
+    std::uint8_t wallHits : 2        = 0;
+    bool         hasShellOverlay : 1 = false;
 };
+static_assert(sizeof(Cell) == 1, "Cell must stay one byte");
 
-/// A toroidal grid of Cells supporting walls, mines, and tanks.
+/// Map-file character for a cell's content (no shell overlay).
+inline char contentToChar(CellContent c) {
+    static constexpr char kChars[] = {' ', '#', '@', '1', '2'};
+    return kChars[static_cast<std::uint8_t>(c)];
+}
+
+/// A toroidal grid of Cells supporting walls, mines, and tanks,
+/// stored as one contiguous row-major buffer. Next to the cells it keeps one
+/// BitLayer per content (walls, mines, tank1, tank2) and one for shell
+/// overlays; every write goes through Board so the two views stay in sync,
+/// and counts and scans run on the layers.
 class Board {
 public:
     Board() = default;
     Board(std::size_t rows, std::size_t cols);
 
+    /// Resize to rows×cols and clear every cell, keeping the allocation when it fits.
+    void reset(std::size_t rows, std::size_t cols) {
+        rows_ = rows;
+        cols_ = cols;
+        cells_.assign(rows * cols, Cell{});
+        for (auto& l : layers_) l.reset(rows, cols);
+        shells_.reset(rows, cols);
+    }
+
     std::size_t getRows()   const { return rows_; }
     std::size_t getCols()   const { return cols_; }
     int         getWidth()  const { return int(cols_); }
     int         getHeight() const { return int(rows_); }
 
-    const std::vector<std::vector<Cell>>& getGrid() const { return grid_; }
+    /// Row-major cells; index(x,y) == y * getCols() + x.
+    const std::vector<Cell>& getCells() const { return cells_; }
+    std::size_t index(int x, int y) const { return std::size_t(y) * cols_ + std::size_t(x); }
 
-    Cell&       getCell(int x, int y)       { return grid_[y][x]; }
-    const Cell& getCell(int x, int y) const { return grid_[y][x]; }
+    const Cell& getCell(int x, int y) const { return cells_[index(x, y)]; }
+    const Cell& cellAt(std::size_t idx) const { return cells_[idx]; }
 
-    /// Sets content at (x,y), resetting wallHits if it becomes a wall.
+    /// Sets content at (x,y), resetting wallHits and the shell overlay.
     void setCell(int x, int y, CellContent c);
+    /// Empties (x,y) but keeps its wall hits and shell overlay (a tank or
+    /// mine destroyed in place).
+    void removeContent(int x, int y) { setContent(x, y, CellContent::EMPTY); }
+    /// One shell hit on the wall at (x,y); true once it falls (second hit).
+    bool hitWall(int x, int y);
+    /// Marks a shell flying over (x,y); cleared by clearShellMarks().
+    void markShell(int x, int y) {
+        cells_[index(x, y)].hasShellOverlay = true;
+        shells_.set(x, y);
+    }
+
+    /// Bits of the cells holding `c` (not EMPTY), and of the shell overlays.
+    const BitLayer& layer(CellContent c) const { return layers_[layerIndex(c)]; }
+    const BitLayer& shellLayer() const { return shells_; }
 
     /// Wraps x,y into valid range [0..width) × [0..height).
-    void wrapCoords(int& x, int& y) const;
+    /// In-range and one-board-off coordinates (every unit move) avoid the division.
+    void wrapCoords(int& x, int& y) const {
+        const int w = int(cols_), h = int(rows_);
+        if (unsigned(x) >= unsigned(w)) x = wrapAxis(x, w);
+        if (unsigned(y) >= unsigned(h)) y = wrapAxis(y, h);
+    }
+
+    /// Number of cells holding the given content (a layer popcount).
+    std::size_t countContent(CellContent c) const;
 
-    /// Clears all shell overlays.
+    /// Counts TANK1 and TANK2 cells (two layer popcounts).
+    void countTanks(std::size_t& p1, std::size_t& p2) const;
+
+    /// Clears all shell overlays, visiting only the marked cells.
     void clearShellMarks();
 
     /// No-op: tanks are tracked in CellContent, not via flags.
@@ -56,8 +106,19 @@ public:
     void loadFromSatelliteView(const SatelliteView& view);
 
 private:
+    static int wrapAxis(int v, int n) {
+        if (v < 0 && v >= -n) return v + n;
+        if (v >= n && v < 2 * n) return v - n;
+        return (v % n + n) % n;
+    }
+
+    static std::size_t layerIndex(CellContent c) { return std::size_t(c) - 1; }
+    void setContent(int x, int y, CellContent c);
+
     // bool verbose_;
     std::size_t rows_ = 0, cols_ = 0;
-    std::vector<std::vector<Cell>> grid_;
+    std::vector<Cell> cells_;
+    BitLayer          layers_[4];   // WALL, MINE, TANK1, TANK2
+    BitLayer          shells_;
 };
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+// include/DynamicBitset.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GameManager_315634022 {
+
+/// Runtime-sized bitset backed by 64-bit words. resize() keeps the
+/// allocation, so a member bitset reused every turn never touches the heap
+/// once it has reached its largest size.
+class DynamicBitset {
+public:
+    class reference {
+    public:
+        reference(std::uint64_t& word, std::uint64_t mask) : word_(word), mask_(mask) {}
+        reference& operator=(bool v) {
+            if (v) word_ |= mask_; else word_ &= ~mask_;
+            return *this;
+        }
+        reference& operator=(const reference& other) { return *this = bool(other); }
+        operator bool() const { return (word_ & mask_) != 0; }
+    private:
+        std::uint64_t& word_;
+        std::uint64_t  mask_;
+    };
+
+    DynamicBitset() = default;
+    explicit DynamicBitset(std::size_t n) { resize(n); }
+
+    /// Resize to n bits, all cleared.
+    void resize(std::size_t n) {
+        size_ = n;
+        words_.assign((n + 63) / 64, 0);
+    }
+
+    /// Clear every bit, keeping the size.
+    void reset() {
+        for (auto& w : words_) w = 0;
+    }
+
+    std::size_t size() const { return size_; }
+
+    bool test(std::size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1u; }
+    void set(std::size_t i)        { words_[i >> 6] |= (std::uint64_t(1) << (i & 63)); }
+
+    bool      operator[](std::size_t i) const { return test(i); }
+    reference operator[](std::size_t i)       { return reference(words_[i >> 6], std::uint64_t(1) << (i & 63)); }
+
+private:
+    std::vector<std::uint64_t> words_;
+    std::size_t                size_ = 0;
+};
+
+} // namespace GameManager_315634022
@@ -0,0 +1,47 @@
+// include/GameArena.h
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <GameState.h>
+
+namespace GameManager_315634022 {
+
+/// Per-thread GameState reused across games.
+///
+/// The simulator runs many games back to back on each pool worker. Instead of
+/// building a fresh Board/GameState per game, the GameManager leases this
+/// thread's arena and calls GameState::reset(), so board cells, tank tables
+/// and shell indexes keep their capacity from game to game.
+class GameArena {
+public:
+    /// RAII lease on the calling thread's arena. If the arena is already
+    /// leased (a nested game on the same thread), a private GameState is used.
+    class Lease {
+    public:
+        Lease();
+        ~Lease();
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        GameState& state() { return *state_; }
+
+    private:
+        GameArena*                 arena_ = nullptr;  // null when using fallback_
+        std::unique_ptr<GameState> fallback_;
+        GameState*                 state_ = nullptr;
+    };
+
+    /// The calling thread's arena.
+    static GameArena& forThisThread();
+
+    /// Number of games this arena has served.
+    std::size_t gamesServed() const { return gamesServed_; }
+
+private:
+    GameState   state_;
+    bool        leased_ = false;
+    std::size_t gamesServed_ = 0;
+};
+
+} // namespace GameManager_315634022
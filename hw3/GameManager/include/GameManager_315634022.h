@@ -3,11 +3,13 @@
 #include <AbstractGameManager.h>
 #include <Board.h>
 #include <GameState.h>
+#include <GameArena.h>
 // #include <FinalBoardView.h>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <memory>
+#include <optional>
 
 namespace GameManager_315634022 {
 
@@ -50,11 +52,14 @@ private:
     );
     void gameLoop();
     GameResult finalize();
+    void writeFinalLine(std::size_t p1, std::size_t p2);
 
     bool                            verbose_;
-    Board                           board_;
-    std::unique_ptr<GameState>      state_;     // Fixed: use pointer to avoid reference member issues
+    std::optional<GameArena::Lease> lease_;     // this thread's reusable GameState, held for one run()
+    GameState*                      state_;
     std::ofstream                   log_file_;
+    bool                            recording_ = false;   // this game goes to the replay file, not log_file_
+    std::string                     replayLogName_;
 };
 
 } // namespace GameManager_315634022
\ No newline at end of file
@@ -4,12 +4,15 @@
 #include <cstddef>
 #include <string>
 #include <vector>
-#include <map>
-#include <set>
+#include <cstdint>
 #include <utility>
 #include <memory>
 
 #include <Board.h>
+#include <RulesState.h>
+#include <DynamicBitset.h>
+#include <PhaseTimer.h>
+#include <Watchdog.h>
 #include <SatelliteView.h>
 #include <Player.h>
 #include <ActionRequest.h>
@@ -19,6 +22,9 @@ namespace GameManager_315634022 {
 
 class GameState {
 public:
+    /// Empty state for reuse through reset() (see GameArena).
+    GameState();
+
     // --- Injected constructor replaces initialize() + factory usage ---
     GameState(
         Board&& board,
@@ -35,13 +41,39 @@ public:
     );
     ~GameState();
 
+    GameState(const GameState&) = delete;
+    GameState& operator=(const GameState&) = delete;
+
+    /// Load a new map and players into this state, reusing all storage.
+    void reset(
+        const SatelliteView& map,
+        std::size_t width,
+        std::size_t height,
+        const std::string& map_name,
+        std::size_t max_steps,
+        std::size_t num_shells,
+        Player& player1,
+        const std::string& name1,
+        Player& player2,
+        const std::string& name2,
+        TankAlgorithmFactory algoFactory1,
+        TankAlgorithmFactory algoFactory2,
+        bool verbose
+    );
+
+    /// Drop players, factories and tank algorithms (which belong to the
+    /// algorithm libraries) while keeping allocated storage.
+    void releaseBindings();
+
     // Query loop status
     bool        isGameOver()     const;
     std::string getResultString() const;
 
     std::size_t getMaxSteps() const {return max_steps_;}
     // Advance mechanics
-    std::string advanceOneTurn();
+    /// Runs one turn and returns its log line. The reference stays valid
+    /// until the next call.
+    const std::string& advanceOneTurn();
 
     // Display state
     void printBoard() const;
@@ -51,17 +83,60 @@ public:
     /// Expose the current board for final‐state snapshotting
     const Board& getBoard() const;
 
+    /// Cycle counters for the current game; off by default, cleared by reset().
+    void setProfiling(bool on) { profiling_ = on; }
+    const GameProfile& getProfile() const { return profile_; }
+    std::size_t getLiveShellCount() const { return rules_.shells.size(); }
+
+    /// Time budgets for the current game in ms, 0 = unlimited (see
+    /// UserCommon/GameLimits.h). Call after reset(); releaseBindings() disarms.
+    void setLimits(std::uint64_t decisionMs, std::uint64_t gameMs);
+    /// What ran out of time in this game; empty if nothing did.
+    const std::string& getTimeoutNote() const { return timeoutNote_; }
+
+    /// Replay recording (see Replay.h): when on, advanceOneTurn() only fills
+    /// the per-tank codes and returns an empty line.
+    void setTurnCodesOnly(bool on) { turnCodesOnly_ = on; }
+    /// Codes of the last turn, one per tank; filled in both modes.
+    const std::vector<std::uint8_t>& getTurnCodes() const { return turnCodes_; }
+    std::size_t getTankCount() const { return rules_.tanks.size(); }
+
+    /// Rules state between turns (see RulesState.h). Cloning copies it out;
+    /// restoring a clone of the same game resumes it at that turn with the
+    /// current players, algorithms and limits.
+    const RulesState& rules() const { return rules_; }
+    void cloneRules(RulesState& out) const { out = rules_; }
+    void restoreRules(const RulesState& in) { rules_ = in; }
+
+    /// Direction (0 = up, clockwise in 45° steps) of the live tank at (x, y), -1 if none.
+    int tankDirectionAt(int x, int y) const;
+    static const char* directionToArrow(int dir);
+
 private:
+    using TankState = RulesState::TankState;
+    using ShellFate = RulesState::ShellFate;
+    using Shell     = RulesState::Shell;
+
+    // Setup helpers shared by the constructor and reset()
+    void bindGame(const std::string& map_name, std::size_t max_steps, std::size_t num_shells,
+                  Player& player1, const std::string& name1,
+                  Player& player2, const std::string& name2,
+                  TankAlgorithmFactory factory1, TankAlgorithmFactory factory2,
+                  bool verbose);
+    void scanTanks();
+    void reserveTurnScratch();
+    void createTankAlgorithms();
+
     // Sub‐step helpers (unchanged)
     void applyTankRotations(const std::vector<ActionRequest>& actions);
     void handleTankMineCollisions();
     void updateTankCooldowns();
-    void confirmBackwardMoves(std::vector<bool>& ignored,
+    void confirmBackwardMoves(DynamicBitset& ignored,
                               const std::vector<ActionRequest>& actions);
-    void updateTankPositionsOnBoard(std::vector<bool>& ignored,
-                                    std::vector<bool>& killedThisTurn,
+    void updateTankPositionsOnBoard(DynamicBitset& ignored,
+                                    DynamicBitset& killedThisTurn,
                                     const std::vector<ActionRequest>& actions);
-    void handleShooting(std::vector<bool>& ignored,
+    void handleShooting(DynamicBitset& ignored,
                         const std::vector<ActionRequest>& actions);
     void updateShellsWithOverrunCheck();
     void resolveShellCollisions();
@@ -73,60 +148,46 @@ private:
     std::unique_ptr<SatelliteView>
     createSatelliteViewFor(int queryX, int queryY) const;
 
-    static const char* directionToArrow(int dir);
-
     // === extracted helpers to keep methods <= 40 lines ===
     void logTurnStart(std::size_t N);
     void gatherActionRequests(std::vector<ActionRequest>& actions,
-                              std::vector<bool>& ignored);
+                              DynamicBitset& ignored);
     void executePhases(std::vector<ActionRequest>& actions,
-                       std::vector<bool>& ignored,
-                       std::vector<bool>& killed);
-    std::string buildTurnLogString(const std::vector<ActionRequest>& logActions,
-                                   const std::vector<bool>& ignored,
-                                   const std::vector<bool>& killed) const;
+                       DynamicBitset& ignored,
+                       DynamicBitset& killed);
+    void buildTurnLog(const std::vector<ActionRequest>& logActions,
+                      const DynamicBitset& ignored);
     // printBoard helpers
     std::string renderRow(std::size_t r) const;
     std::string tankArrowAt(std::size_t r, std::size_t c) const;
     // shell update helpers
-    std::vector<std::pair<int,int>> computeShellDeltas() const;
+    void computeShellDeltas(std::vector<std::pair<int,int>>& delta) const;
     void processShellHalfStep(const std::vector<std::pair<int,int>>& delta,
                               const std::vector<std::pair<int,int>>& oldPos,
                               int step);
+    // dense per-cell shell index helpers
+    void indexShellsAt(const std::vector<std::pair<int,int>>& pos);
+    void clearShellIndex();
+    int  firstUnconsumedShellAt(int x, int y) const;
+    void recordShellVisit(int x, int y, std::size_t shell);
 
     // ---- Internal state ----
-    bool                     verbose_;
-    Board                    board_;
+    bool                     verbose_ = false;
+    RulesState               rules_;        // board, tanks, shells, counters
     std::string              map_name_;
-    std::size_t              max_steps_, currentStep_;
-    std::size_t              num_shells_;
-
-    bool                     gameOver_;
-    std::string              resultStr_;
+    std::size_t              max_steps_ = 0;
+    std::size_t              num_shells_ = 0;
 
     // Board dimensions & tank indexing
-    std::size_t              rows_, cols_;
-    int                      nextTankIndex_[3];
-
-    // Tanks
-    struct TankState {
-        int           player_index;
-        int           tank_index;
-        int           x, y;
-        int           direction;
-        bool          alive;
-        std::size_t   shells_left;
-        int           shootCooldown;
-        int           backwardDelayCounter;
-        bool          lastActionBackwardExecuted;
-    };
-    std::vector<TankState>   all_tanks_;
+    std::size_t              rows_ = 0, cols_ = 0;
+    int                      nextTankIndex_[3] = {0, 0, 0};
+
     std::vector<std::vector<std::size_t>> tankIdMap_;
 
     // Injected players
-    Player&                  p1_;
+    Player*                  p1_ = nullptr;
     std::string              name1_;
-    Player&                  p2_;
+    Player*                  p2_ = nullptr;
     std::string              name2_;
 
     // Algorithm factories (one per player)
@@ -134,13 +195,61 @@ private:
     TankAlgorithmFactory     algoFactory2_;
     std::vector<std::unique_ptr<TankAlgorithm>> all_tank_algorithms_;
 
-    // Shells & mapping
-    struct Shell { int x, y, dir; };
-    std::vector<Shell>       shells_;
-    std::set<std::size_t>    toRemove_;
-    std::map<std::pair<int,int>, std::vector<std::size_t>> positionMap_;
-
-    std::size_t              zeroShellsStreak_ = 0;
+    // Dense per-cell shell index (sized rows*cols once, reset via the touched lists)
+    std::vector<int>           cellShellHead_;  // first shell id in cell, -1 if none
+    std::vector<int>           shellNext_;      // next shell id in the same cell, ascending
+    std::vector<std::size_t>   indexedCells_;   // cells with a non-empty head
+    std::vector<std::uint32_t> cellVisits_;     // half-step landings per cell this turn
+    std::vector<std::pair<std::size_t, std::size_t>> visitLog_;  // (cell, shell) landings
+
+    // Per-turn scratch, sized once per game by reserveTurnScratch()
+    std::vector<ActionRequest>       actions_, logActions_;
+    DynamicBitset                    ignored_, killed_;
+    std::vector<std::pair<int,int>>  tankOldPos_, tankNewPos_;
+    std::vector<std::size_t>         movers_;
+    std::vector<std::uint8_t>        destCount_;   // per cell, number of tanks moving into it
+    std::vector<std::pair<int,int>>  shellPos_, shellDelta_;
+    std::vector<std::uint8_t>        turnCodes_;
+    std::string                      turnLog_;
+    bool                             turnCodesOnly_ = false;
+
+    // Optional cycle counters (see PhaseTimer.h) and time budgets (see Watchdog.h)
+    GameProfile* activeProfile() { return profiling_ ? &profile_ : nullptr; }
+    template <typename F>
+    decltype(auto) timedAlgorithmCall(int player, F&& call) {
+        if (!limited_) return profiledAlgorithmCall(player, call);
+        BudgetedCall budget(*this, player);
+        return profiledAlgorithmCall(player, call);
+    }
+    template <typename F>
+    decltype(auto) profiledAlgorithmCall(int player, F& call) {
+        if (!profiling_) return call();
+        const std::size_t side = (player == 1) ? 0 : 1;
+        ++profile_.algoCalls[side];
+        ScopedCycles scope(&profile_.algoCycles[side]);
+        return call();
+    }
+    bool        profiling_ = false;
+    GameProfile profile_;
+
+    // Arms the decision deadline for the watchdog and measures the call
+    struct BudgetedCall {
+        GameState&   gs;
+        std::size_t  side;
+        std::int64_t start;
+        BudgetedCall(GameState& g, int player);
+        ~BudgetedCall();
+    };
+    bool decisionOverran() const { return decisionBudgetNs_ > 0 && lastCallNs_ > decisionBudgetNs_; }
+    void disarmLimits();
+    void forfeitTank(std::size_t k);
+    void forfeitOnGameBudget();
+    bool         limited_ = false;
+    GameWatch    watch_;
+    std::int64_t decisionBudgetNs_ = 0, gameBudgetNs_ = 0;
+    std::int64_t lastCallNs_ = 0;
+    std::int64_t algoNs_[2] = {0, 0};   // per player, this game
+    std::string  timeoutNote_;
 };
 
 } // namespace GameManager_315634022
@@ -0,0 +1,74 @@
+// include/Logging.h
+#pragma once
+
+#include <string>
+
+// ——————————————————————————————————————————————————————
+// Leveled logging for the GameManager
+// ——————————————————————————————————————————————————————
+//
+// Two gates, both checked before the message expression is evaluated:
+//   * build time: GM_LOG_LEVEL (set via `make LOG_LEVEL=TRACE|DEBUG|INFO|WARN|ERROR|OFF`).
+//     Statements below it are discarded by `if constexpr`, so they cost nothing.
+//   * run time:   environment variable GM_LOG_LEVEL (same names, default INFO),
+//     read once when the library loads; a relaxed atomic load per call site.
+//
+// Per-turn messages use TRACE; per-game messages use DEBUG/INFO.
+
+#define GM_LOG_LEVEL_TRACE 0
+#define GM_LOG_LEVEL_DEBUG 1
+#define GM_LOG_LEVEL_INFO  2
+#define GM_LOG_LEVEL_WARN  3
+#define GM_LOG_LEVEL_ERROR 4
+#define GM_LOG_LEVEL_OFF   5
+
+#ifndef GM_LOG_LEVEL
+#define GM_LOG_LEVEL GM_LOG_LEVEL_INFO
+#endif
+
+namespace GameManager_315634022 {
+namespace logging {
+
+/// Current runtime threshold (one of the GM_LOG_LEVEL_* values).
+int  runtimeLevel();
+void setRuntimeLevel(int level);
+
+inline bool enabled(int level) { return level >= runtimeLevel(); }
+
+/// Writes one "[T<id>] [LEVEL] [component] [function] message" line.
+/// INFO and below go to stdout, WARN and ERROR to stderr.
+void write(int level, const char* component, const char* function, const std::string& message);
+
+/// Writes a pre-formatted multi-line block to stdout under the log lock.
+void writeBlock(const std::string& block);
+
+} // namespace logging
+} // namespace GameManager_315634022
+
+#define GM_LOG_ENABLED(level) \
+    (GM_LOG_LEVEL <= GM_LOG_LEVEL_##level && \
+     ::GameManager_315634022::logging::enabled(GM_LOG_LEVEL_##level))
+
+#define GM_LOG_IF(level, cond, component, function, message) \
+    do { \
+        if constexpr (GM_LOG_LEVEL <= GM_LOG_LEVEL_##level) { \
+            if ((cond) && ::GameManager_315634022::logging::enabled(GM_LOG_LEVEL_##level)) { \
+                ::GameManager_315634022::logging::write(GM_LOG_LEVEL_##level, component, function, message); \
+            } \
+        } \
+    } while(0)
+
+#define TRACE_PRINT(component, function, message) \
+    GM_LOG_IF(TRACE, true, component, function, message)
+
+#define DEBUG_PRINT(component, function, message, debug_flag) \
+    GM_LOG_IF(DEBUG, debug_flag, component, function, message)
+
+#define INFO_PRINT(component, function, message) \
+    GM_LOG_IF(INFO, true, component, function, message)
+
+#define WARN_PRINT(component, function, message) \
+    GM_LOG_IF(WARN, true, component, function, message)
+
+#define ERROR_PRINT(component, function, message) \
+    GM_LOG_IF(ERROR, true, component, function, message)
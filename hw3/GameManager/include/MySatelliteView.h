@@ -1,47 +1,37 @@
 // MySatelliteView.h
 #pragma once
 #include <SatelliteView.h>
-#include <vector>
+#include <cstddef>
+#include "Board.h"
 
 namespace GameManager_315634022 {
 
+/// Read-only window onto the live Board for a GetBattleInfo request.
+/// Nothing is copied: cells are rendered on demand, the querying tank's own
+/// cell reads as '%', and anything outside the board reads as '&'.
+/// Valid only while the Board is alive and unchanged, i.e. for the duration
+/// of the updateTankWithBattleInfo() call it is passed to.
 class MySatelliteView : public SatelliteView {
 public:
-    // Multiple data representations to match what external algorithms might expect
-    std::vector<std::vector<char>> grid;  // 2D grid
-    std::vector<char> flat_grid;          // 1D flattened grid
-    std::size_t rows;
-    std::size_t cols;
-    int tank_x;
-    int tank_y;
+    MySatelliteView(const Board& board, int tank_x, int tank_y);
 
-private:
-    std::vector<char*> row_pointers_;
-
-public:
-    MySatelliteView(const std::vector<std::vector<char>>& input_grid, 
-                    std::size_t input_rows, std::size_t input_cols, 
-                    int input_tank_x, int input_tank_y);
-    
-    virtual ~MySatelliteView() = default;
-    
-    // Implement the pure virtual function from SatelliteView
-    virtual char getObjectAt(size_t x, size_t y) const override {
-        if (x >= cols || y >= rows) return '&';   // ← new
-        // if (x >= cols_ || y >= rows_) return '&';   // ← new
-        return grid[y][x];
+    char getObjectAt(size_t x, size_t y) const override {
+        if (x >= cols_ || y >= rows_) return '&';
+        if (x == tank_x_ && y == tank_y_) return '%';
+        return contentToChar(board_.cellAt(y * cols_ + x).content);
     }
-    
-    // Provide accessors
-    std::size_t getRows() const { return rows; }
-    std::size_t getCols() const { return cols; }
-    int getTankX() const { return tank_x; }
-    int getTankY() const { return tank_y; }
-    char** getGrid() const { return const_cast<char**>(row_pointers_.data()); }
-    
-    // Additional accessors for potential compatibility
-    const std::vector<char>& getFlatGrid() const { return flat_grid; }
-    char* getFlatGridPtr() { return flat_grid.data(); }
+
+    std::size_t getRows() const { return rows_; }
+    std::size_t getCols() const { return cols_; }
+    int getTankX() const { return static_cast<int>(tank_x_); }
+    int getTankY() const { return static_cast<int>(tank_y_); }
+
+private:
+    const Board& board_;
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t tank_x_;   // == cols_ when the tank is off-board (no overlay)
+    std::size_t tank_y_;
 };
 
 } // namespace GameManager_315634022
@@ -0,0 +1,56 @@
+// include/PhaseTimer.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <GameProfile.h>
+
+namespace GameManager_315634022 {
+
+using UserCommon_315634022::GameProfile;
+using UserCommon_315634022::readCycles;
+
+/// Steps of a turn as timed by GameState. Order matches executePhases()
+/// and GameProfile::kPhaseNames.
+enum class Phase : std::uint8_t {
+    Gather,          // asking algorithms for actions (incl. GetBattleInfo)
+    Rotations,
+    MineHits,
+    Cooldowns,
+    BackwardMoves,
+    ShellMoves,
+    ShellHits,
+    Shooting,
+    TankMoves,
+    ShellFilter,
+    Cleanup,
+    EndCheck,
+    Count
+};
+static_assert(static_cast<std::size_t>(Phase::Count) == GameProfile::kPhaseCount,
+              "Phase and GameProfile::kPhaseNames must stay in sync");
+
+inline const char* phaseName(Phase p) {
+    return GameProfile::kPhaseNames[static_cast<std::size_t>(p)];
+}
+
+/// Adds the cycles spent in its scope to one GameProfile slot. A null
+/// profile (profiling off) costs one predictable branch and no counter read.
+class ScopedCycles {
+public:
+    explicit ScopedCycles(std::uint64_t* slot) : slot_(slot), start_(slot ? readCycles() : 0) {}
+    ~ScopedCycles() { if (slot_) *slot_ += readCycles() - start_; }
+    ScopedCycles(const ScopedCycles&) = delete;
+    ScopedCycles& operator=(const ScopedCycles&) = delete;
+private:
+    std::uint64_t* slot_;
+    std::uint64_t  start_;
+};
+
+/// Time the rest of the enclosing scope into `phase` of `profile` (a GameProfile*, may be null).
+#define GM_PHASE_SCOPE(profile, phase) \
+    ::GameManager_315634022::ScopedCycles gm_phase_scope_( \
+        (profile) ? &(profile)->phaseCycles[static_cast<std::size_t>(phase)] : nullptr)
+
+} // namespace GameManager_315634022
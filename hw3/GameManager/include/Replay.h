@@ -0,0 +1,119 @@
+// include/Replay.h
+#pragma once
+
+#include <ActionRequest.h>
+#include <SatelliteView.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GameManager_315634022 {
+
+/// Binary replay container (replay_file=<file>), replacing the per-game
+/// text logs. The file is a plain sequence of game records; every record
+/// starts with a fixed header that carries its total size, so listing or
+/// seeking reads only headers (the record chain is the index). Records are
+/// appended with a single O_APPEND write each, so pool threads and worker
+/// processes can share one file without locking.
+///
+/// Record layout (little-endian):
+///     RecordHeader
+///     5 strings (u32 length + bytes): log name, map name, player 1, player 2, final line
+///     initial board: rows*cols cells, row-major
+///     turn stream: turns*tanks codes of kCodeBits bits, LSB-first
+/// A tank's code is action*3 + TankMark; it holds exactly what the text log
+/// shows for that tank in that turn.
+namespace replay {
+
+inline constexpr char          kMagic[4] = {'T', 'R', 'P', 'L'};
+inline constexpr std::uint32_t kVersion  = 1;
+inline constexpr unsigned      kCodeBits = 5;
+
+enum TankMark : std::uint8_t { Plain = 0, Ignored = 1, Killed = 2 };
+
+inline std::uint8_t tankCode(ActionRequest a, TankMark m) {
+    return static_cast<std::uint8_t>(static_cast<int>(a) * 3 + m);
+}
+inline ActionRequest codeAction(std::uint8_t code) { return static_cast<ActionRequest>(code / 3); }
+inline TankMark      codeMark(std::uint8_t code)   { return static_cast<TankMark>(code % 3); }
+
+const char* actionName(ActionRequest a);
+
+/// Append one tank's entry of a turn's log line, e.g. "Shoot (ignored)".
+void appendTankEntry(std::string& out, std::uint8_t code);
+/// The full text-log line for one turn.
+std::string turnLine(const std::uint8_t* codes, std::size_t tanks);
+
+struct RecordHeader {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t recordSize;   // whole record, header included
+    std::uint64_t mapHash;      // FNV-1a over the initial board cells
+    std::uint32_t rows, cols, maxSteps, numShells;
+    std::uint32_t tanks, turns;
+};
+
+/// One decoded record.
+struct Game {
+    RecordHeader header{};
+    std::string  logName, mapName, name1, name2, finalLine;
+    std::string  board;                 // initial cells, row-major
+    std::vector<std::uint8_t> codes;    // turns*tanks tank codes
+
+    const std::uint8_t* turn(std::size_t t) const { return codes.data() + t * header.tanks; }
+    /// The text log this game would have written.
+    std::string textLog() const;
+};
+
+/// FNV-1a over rows*cols cells of a view.
+std::uint64_t hashBoard(const SatelliteView& view, std::size_t rows, std::size_t cols);
+
+/// Builds one record per game in a reusable buffer; one per thread.
+class Writer {
+public:
+    void begin(const std::string& logName, const std::string& mapName,
+               const std::string& name1, const std::string& name2,
+               const SatelliteView& map, std::size_t rows, std::size_t cols,
+               std::size_t maxSteps, std::size_t numShells, std::size_t tanks);
+    void addTurn(const std::vector<std::uint8_t>& codes);
+    /// Assemble the record and append it to `fd`; false on a write error.
+    bool finish(const std::string& finalLine, int fd);
+
+private:
+    RecordHeader header_{};
+    std::string  strings_[4];
+    std::string  board_;
+    std::string  bits_;             // packed turn stream
+    std::uint64_t bitCount_ = 0;
+    std::string  record_;           // assembled record, reused across games
+};
+
+/// Process-wide container file; opened once, shared by every thread (and by
+/// forked worker processes, which inherit the descriptor).
+bool openContainer(const std::string& path);
+int  containerFd();
+
+/// Reads a container; open() indexes it by walking the record headers.
+class Reader {
+public:
+    struct Entry {
+        std::uint64_t offset = 0;
+        RecordHeader  header{};
+        std::string   logName;
+    };
+
+    bool open(const std::string& path);
+    const std::vector<Entry>& entries() const { return entries_; }
+    /// True if the file ended in a partial or corrupt record (ignored).
+    bool truncated() const { return truncated_; }
+    bool load(std::size_t index, Game& out) const;
+
+private:
+    std::string        path_;
+    std::vector<Entry> entries_;
+    bool               truncated_ = false;
+};
+
+} // namespace replay
+} // namespace GameManager_315634022
@@ -0,0 +1,54 @@
+// include/RulesState.h
+#pragma once
+
+#include <Board.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace GameManager_315634022 {
+
+/// Everything the game rules read and write between turns: board, tanks,
+/// shells and counters. It holds no players, algorithms or per-turn
+/// scratch, so it can be copied freely to clone a game for look-ahead,
+/// replay seeking or differential tests.
+///
+/// Every member is a flat buffer of trivially copyable values; copy
+/// assignment is a handful of memcpys and, into a target that already held
+/// a state of this game, allocates nothing (vectors keep their capacity).
+struct RulesState {
+    struct TankState {
+        int           player_index;
+        int           tank_index;
+        int           x, y;
+        int           direction;
+        bool          alive;
+        std::size_t   shells_left;
+        int           shootCooldown;
+        int           backwardDelayCounter;
+        bool          lastActionBackwardExecuted;
+    };
+
+    enum class ShellFate : std::uint8_t {
+        Live,        // still flying
+        Destroyed,   // hit a wall/tank/shell this turn; dropped by filterRemainingShells
+        Consumed     // taken out by a tank driving into it; no longer hits anything
+    };
+    struct Shell { int x, y, dir; ShellFate fate = ShellFate::Live; };
+
+    Board                  board;
+    std::vector<TankState> tanks;
+    std::vector<Shell>     shells;
+    std::size_t            step = 0;               // turns played
+    std::size_t            zeroShellsStreak = 0;
+    bool                   gameOver = false;
+    std::string            result;                 // final log line once gameOver
+};
+
+static_assert(std::is_trivially_copyable_v<Cell>);
+static_assert(std::is_trivially_copyable_v<RulesState::TankState>);
+static_assert(std::is_trivially_copyable_v<RulesState::Shell>);
+
+} // namespace GameManager_315634022
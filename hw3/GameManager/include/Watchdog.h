@@ -0,0 +1,65 @@
+// include/Watchdog.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GameManager_315634022 {
+
+/// Deadlines of one running game. The game arms them; the watchdog thread
+/// only raises the expired flag, which the game polls at its own safe
+/// points (cooperative cancellation: nothing is ever interrupted).
+struct GameWatch {
+    std::atomic<std::int64_t> decisionDeadline{0};   // steady-clock ns, 0 = no decision running
+    std::atomic<std::int64_t> gameDeadline{0};       // 0 = unlimited
+    std::atomic<bool>         gameExpired{false};
+    std::int64_t              decisionBudgetNs = 0;  // set before watch(); used for hang reports
+    std::int64_t              hangReported = 0;      // watchdog only: deadline already reported as hung
+};
+
+/// One process-wide thread that checks every watched game each tick.
+/// A decision still running long after its deadline is reported once: it
+/// cannot be reclaimed in-process. Inside an isolation=process worker
+/// (setExitOnHang) the watchdog instead ends the worker, which the
+/// simulator replaces.
+class Watchdog {
+public:
+    static Watchdog& instance();
+    static std::int64_t nowNs();
+
+    /// Register/unregister a game; the thread starts on first use.
+    void watch(GameWatch* w);
+    void unwatch(GameWatch* w);
+
+    /// Check interval; the smallest requested value wins.
+    void requestTick(std::int64_t ns);
+
+    /// _exit(kHangExitStatus) on a hung call instead of only reporting it.
+    void setExitOnHang(bool on) { exitOnHang_.store(on, std::memory_order_relaxed); }
+
+    ~Watchdog();
+
+private:
+    Watchdog() = default;
+    void run();
+    void check(GameWatch& w, std::int64_t now);
+
+    static constexpr std::int64_t kMinTickNs = 1'000'000;        // 1 ms
+    static constexpr std::int64_t kMaxTickNs = 50'000'000;       // 50 ms
+    static constexpr std::int64_t kHangFactor = 10;              // "hung" = 10x the decision budget
+    static constexpr std::int64_t kMinHangNs = 1'000'000'000;    // but at least 1 s
+
+    std::mutex              mutex_;
+    std::condition_variable cond_;
+    std::vector<GameWatch*> games_;
+    std::int64_t            tickNs_ = kMaxTickNs;
+    bool                    stop_ = false;
+    std::atomic<bool>       exitOnHang_{false};
+    std::thread             thread_;
+};
+
+} // namespace GameManager_315634022
@@ -0,0 +1,112 @@
+// src/BitBoard.cpp
+#include "BitBoard.h"
+
+#include <cstring>
+
+#if defined(GM_BITBOARD_SCALAR)
+#  define GM_BITBOARD_AVX2 0
+#  define GM_BITBOARD_SSE2 0
+#elif defined(__AVX2__)
+#  define GM_BITBOARD_AVX2 1
+#  define GM_BITBOARD_SSE2 0
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  define GM_BITBOARD_AVX2 0
+#  define GM_BITBOARD_SSE2 1
+#  include <emmintrin.h>
+#else
+#  define GM_BITBOARD_AVX2 0
+#  define GM_BITBOARD_SSE2 0
+#endif
+
+namespace GameManager_315634022 {
+
+// ---------- kernels ----------
+namespace bitkernels {
+
+namespace {
+
+std::size_t popcountScalar(const std::uint64_t* w, std::size_t n) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) total += std::size_t(std::popcount(w[i]));
+    return total;
+}
+
+#if GM_BITBOARD_AVX2
+// Nibble lookup through vpshufb, byte sums through vpsadbw
+std::size_t popcountAvx2(const std::uint64_t* w, std::size_t n) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+        const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return std::size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + popcountScalar(w + i, n - i);
+}
+#endif
+
+#if GM_BITBOARD_SSE2
+// SSE2 has no byte shuffle: SWAR bit counts per byte, summed with psadbw
+std::size_t popcountSse2(const std::uint64_t* w, std::size_t n) {
+    const __m128i m1 = _mm_set1_epi8(0x55), m2 = _mm_set1_epi8(0x33), m4 = _mm_set1_epi8(0x0f);
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+        v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+        v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+    }
+    alignas(16) std::uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return std::size_t(lanes[0] + lanes[1]) + popcountScalar(w + i, n - i);
+}
+#endif
+
+} // namespace
+
+std::size_t popcount(const std::uint64_t* words, std::size_t n) {
+#if GM_BITBOARD_AVX2
+    return popcountAvx2(words, n);
+#elif GM_BITBOARD_SSE2
+    return popcountSse2(words, n);
+#else
+    return popcountScalar(words, n);
+#endif
+}
+
+// memset already uses the widest stores the target has
+void zero(std::uint64_t* words, std::size_t n) {
+    if (n) std::memset(words, 0, n * sizeof(std::uint64_t));
+}
+
+const char* name() {
+#if GM_BITBOARD_AVX2
+    return "avx2";
+#elif GM_BITBOARD_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace bitkernels
+
+// ---------- BitLayer ----------
+
+void BitLayer::reset(std::size_t rows, std::size_t cols) {
+    rows_ = rows;
+    cols_ = cols;
+    wordsPerRow_ = (cols + 63) / 64;
+    words_.assign(rows * wordsPerRow_, 0);
+}
+
+} // namespace GameManager_315634022
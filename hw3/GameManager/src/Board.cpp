@@ -1,39 +1,26 @@
 // src/Board.cpp
 #include "Board.h"
+#include "Logging.h"
 #include <iostream>
 #include <sstream>
-#include <mutex>
-#include <thread>
 
 using namespace GameManager_315634022;
 
-// ——————————————————————————————————————————————————————
-// Professional Debug Logging System
-// ——————————————————————————————————————————————————————
-
-static std::mutex g_debug_mutex;
-
-#define DEBUG_PRINT(component, function, message, debug_flag) \
-    do { if (debug_flag) { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cout << "[T" << std::this_thread::get_id() << "] [DEBUG] [" << component \
-              << "] [" << function << "] " << message << std::endl; }} while(0)
-
-#define INFO_PRINT(component, function, message) \
-    do { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cout << "[T" << std::this_thread::get_id() << "] [INFO] [" << component \
-              << "] [" << function << "] " << message << std::endl; } while(0)
-
-#define WARN_PRINT(component, function, message) \
-    do { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cerr << "[T" << std::this_thread::get_id() << "] [WARN] [" << component \
-              << "] [" << function << "] " << message << std::endl; } while(0)
-
-#define ERROR_PRINT(component, function, message) \
-    do { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cerr << "[T" << std::this_thread::get_id() << "] [ERROR] [" << component \
-              << "] [" << function << "] " << message << std::endl; } while(0)
-
 namespace {
+    // Map character -> cell content; anything unrecognised is empty.
+    struct CharToContent {
+        GameManager_315634022::CellContent table[256] = {};
+        constexpr CharToContent() {
+            using CC = GameManager_315634022::CellContent;
+            table[static_cast<unsigned char>('#')] = CC::WALL;
+            table[static_cast<unsigned char>('@')] = CC::MINE;
+            table[static_cast<unsigned char>('1')] = CC::TANK1;
+            table[static_cast<unsigned char>('2')] = CC::TANK2;
+        }
+        GameManager_315634022::CellContent operator[](unsigned char c) const { return table[c]; }
+    };
+    constexpr CharToContent kCharToContent{};
+
     struct BoardStats { size_t walls=0, mines=0, t1=0, t2=0, empty=0; };
 
     inline void tallyCell(BoardStats& s, GameManager_315634022::CellContent c) {
@@ -80,29 +67,53 @@ namespace {
 
 Board::Board(std::size_t rows, std::size_t cols)
   : rows_(rows), cols_(cols),
-    grid_(rows, std::vector<Cell>(cols))
+    cells_(rows * cols)
 {
+    for (auto& l : layers_) l.reset(rows, cols);
+    shells_.reset(rows, cols);
     DEBUG_PRINT("BOARD", "constructor", 
         "Board created with dimensions: " + std::to_string(rows) + "x" + std::to_string(cols), true);
 }
 
+// Content change at (x,y), mirrored into the layers
+void Board::setContent(int x, int y, CellContent c) {
+    Cell& cell = cells_[index(x, y)];
+    if (cell.content != CellContent::EMPTY) layers_[layerIndex(cell.content)].unset(x, y);
+    if (c != CellContent::EMPTY)            layers_[layerIndex(c)].set(x, y);
+    cell.content = c;
+}
+
 void Board::setCell(int x, int y, CellContent c) {
-    Cell& cell = grid_[y][x];
-    cell.content         = c;
-    cell.wallHits        = (c == CellContent::WALL ? 0 : 0);
+    setContent(x, y, c);
+    Cell& cell = cells_[index(x, y)];
+    cell.wallHits        = 0;
     cell.hasShellOverlay = false;
+    shells_.unset(x, y);
 }
 
-void Board::wrapCoords(int& x, int& y) const {
-    int w = int(cols_), h = int(rows_);
-    x = (x % w + w) % w;
-    y = (y % h + h) % h;
+bool Board::hitWall(int x, int y) {
+    Cell& cell = cells_[index(x, y)];
+    cell.wallHits++;
+    if (cell.wallHits < 2) return false;
+    setContent(x, y, CellContent::EMPTY);
+    return true;
 }
 
 void Board::clearShellMarks() {
-    for (auto& row : grid_)
-        for (auto& cell : row)
-            cell.hasShellOverlay = false;
+    shells_.forEachSet([this](int x, int y) { cells_[index(x, y)].hasShellOverlay = false; });
+    shells_.clear();
+}
+
+std::size_t Board::countContent(CellContent c) const {
+    if (c != CellContent::EMPTY) return layer(c).count();
+    std::size_t occupied = 0;
+    for (const auto& l : layers_) occupied += l.count();
+    return cells_.size() - occupied;
+}
+
+void Board::countTanks(std::size_t& p1, std::size_t& p2) const {
+    p1 = layer(CellContent::TANK1).count();
+    p2 = layer(CellContent::TANK2).count();
 }
 
 void Board::loadFromSatelliteView(const SatelliteView& sv) {
@@ -110,22 +121,18 @@ void Board::loadFromSatelliteView(const SatelliteView& sv) {
         "Loading board from SatelliteView - dimensions: " + std::to_string(rows_) + "x" + std::to_string(cols_));
 
     BoardStats stats;
+    Cell* out = cells_.data();
     for (std::size_t y = 0; y < rows_; ++y) {
-        for (std::size_t x = 0; x < cols_; ++x) {
-            char c = sv.getObjectAt(x, y);
-            switch (c) {
-                case '#':  setCell(x, y, CellContent::WALL);  tallyCell(stats, CellContent::WALL);  break;
-                case '@':  setCell(x, y, CellContent::MINE);  tallyCell(stats, CellContent::MINE);  break;
-                case '1':  setCell(x, y, CellContent::TANK1); tallyCell(stats, CellContent::TANK1);
-                           DEBUG_PRINT("BOARD", "loadFromSatelliteView", 
-                               "Player 1 tank found at (" + std::to_string(x) + "," + std::to_string(y) + ")", true);
-                           break;
-                case '2':  setCell(x, y, CellContent::TANK2); tallyCell(stats, CellContent::TANK2);
-                           DEBUG_PRINT("BOARD", "loadFromSatelliteView", 
-                               "Player 2 tank found at (" + std::to_string(x) + "," + std::to_string(y) + ")", true);
-                           break;
-                default:   setCell(x, y, CellContent::EMPTY); tallyCell(stats, CellContent::EMPTY); break;
-            }
+        for (std::size_t x = 0; x < cols_; ++x, ++out) {
+            const CellContent c = kCharToContent[static_cast<unsigned char>(sv.getObjectAt(x, y))];
+            *out = Cell{};
+            out->content = c;
+            if (c != CellContent::EMPTY) layers_[layerIndex(c)].set(int(x), int(y));
+            tallyCell(stats, c);
+            DEBUG_PRINT("BOARD", "loadFromSatelliteView",
+                "Player " + std::string(c == CellContent::TANK1 ? "1" : "2") +
+                " tank found at (" + std::to_string(x) + "," + std::to_string(y) + ")",
+                c == CellContent::TANK1 || c == CellContent::TANK2);
         }
     }
 
@@ -0,0 +1,33 @@
+// src/GameArena.cpp
+#include "GameArena.h"
+#include "Logging.h"
+
+namespace GameManager_315634022 {
+
+GameArena& GameArena::forThisThread() {
+    thread_local GameArena arena;
+    return arena;
+}
+
+GameArena::Lease::Lease() {
+    GameArena& arena = GameArena::forThisThread();
+    if (!arena.leased_) {
+        arena.leased_ = true;
+        ++arena.gamesServed_;
+        arena_ = &arena;
+        state_ = &arena.state_;
+        DEBUG_PRINT("GAMEARENA", "lease",
+            "Reusing thread arena (game #" + std::to_string(arena.gamesServed_) + ")", true);
+    } else {
+        fallback_ = std::make_unique<GameState>();
+        state_ = fallback_.get();
+        DEBUG_PRINT("GAMEARENA", "lease", "Arena busy on this thread; using a private GameState", true);
+    }
+}
+
+GameArena::Lease::~Lease() {
+    state_->releaseBindings();
+    if (arena_) arena_->leased_ = false;
+}
+
+} // namespace GameManager_315634022
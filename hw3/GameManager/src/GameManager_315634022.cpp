@@ -1,53 +1,24 @@
 #include "GameManager_315634022.h"
+#include "Logging.h"
+#include "Replay.h"
+#include "Watchdog.h"
 #include <GameManagerRegistration.h>
+#include <GameProfile.h>
+#include <GameLimits.h>
+#include <GameReplay.h>
 #include <SatelliteView.h>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
 #include <sstream>
 #include <iomanip>
-#include <mutex>
-#include <thread>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
 using namespace GameManager_315634022;
 
-// ——————————————————————————————————————————————————————
-// Thread-safe console logging
-// ——————————————————————————————————————————————————————
-static std::mutex g_debug_mutex;
-
-#define DEBUG_PRINT(component, function, message, debug_flag) \
-    do { \
-        if (debug_flag) { \
-            std::lock_guard<std::mutex> lock(g_debug_mutex); \
-            std::cout << "[T" << std::this_thread::get_id() << "] [DEBUG] [" \
-                      << component << "] [" << function << "] " << message << std::endl; \
-        } \
-    } while(0)
-
-#define INFO_PRINT(component, function, message) \
-    do { \
-        std::lock_guard<std::mutex> lock(g_debug_mutex); \
-        std::cout << "[T" << std::this_thread::get_id() << "] [INFO] [" \
-                  << component << "] [" << function << "] " << message << std::endl; \
-    } while(0)
-
-#define WARN_PRINT(component, function, message) \
-    do { \
-        std::lock_guard<std::mutex> lock(g_debug_mutex); \
-        std::cerr << "[T" << std::this_thread::get_id() << "] [WARN] [" \
-                  << component << "] [" << function << "] " << message << std::endl; \
-    } while(0)
-
-#define ERROR_PRINT(component, function, message) \
-    do { \
-        std::lock_guard<std::mutex> lock(g_debug_mutex); \
-        std::cerr << "[T" << std::this_thread::get_id() << "] [ERROR] [" \
-                  << component << "] [" << function << "] " << message << std::endl; \
-    } while(0)
-
 namespace {
 
 // ---------- small utils ----------
@@ -94,11 +65,9 @@ public:
     explicit OwningSatelliteView(const Board& B)
         : rows_(B.getRows()), cols_(B.getCols()), grid_(rows_ * cols_, ' ')
     {
-        for (size_t y = 0; y < rows_; ++y) {
-            for (size_t x = 0; x < cols_; ++x) {
-                const auto& cell = B.getCell(static_cast<int>(x), static_cast<int>(y));
-                grid_[y * cols_ + x] = renderCell(cell);
-            }
+        const auto& cells = B.getCells();
+        for (size_t i = 0; i < cells.size(); ++i) {
+            grid_[i] = renderCell(cells[i]);
         }
     }
 
@@ -146,8 +115,60 @@ inline std::string summarizeGameResult(const GameResult& gr, const Board& B) {
     return os.str();
 }
 
+// ---------- optional profiling (see UserCommon/GameProfile.h) ----------
+std::atomic<bool> g_profiling{false};
+
+// Profile of the last game finished on this thread; the Simulator fetches it
+// right after run() returns, on the same worker.
+thread_local UserCommon_315634022::GameProfile t_lastProfile;
+thread_local bool                              t_hasProfile = false;
+
+// ---------- optional time budgets (see UserCommon/GameLimits.h) ----------
+std::atomic<std::uint64_t> g_decisionMs{0};
+std::atomic<std::uint64_t> g_gameMs{0};
+
+// Timeout note of the last game finished on this thread, fetched like the profile
+thread_local std::string t_lastTimeout;
+
+// ---------- optional replay recording (see UserCommon/GameReplay.h) ----------
+// Each thread builds its record in its own writer and appends it whole.
+thread_local replay::Writer t_replay;
+
 } // namespace
 
+extern "C" void GameManager_setProfiling(int enabled) {
+    g_profiling.store(enabled != 0, std::memory_order_relaxed);
+}
+
+extern "C" int GameManager_lastGameProfile(UserCommon_315634022::GameProfile* out) {
+    if (!out || !t_hasProfile) return 0;
+    *out = t_lastProfile;
+    t_hasProfile = false;
+    return 1;
+}
+
+extern "C" void GameManager_setLimits(const UserCommon_315634022::GameLimits* limits) {
+    g_decisionMs.store(limits ? limits->decisionMs : 0, std::memory_order_relaxed);
+    g_gameMs.store(limits ? limits->gameMs : 0, std::memory_order_relaxed);
+    Watchdog::instance().setExitOnHang(limits && limits->exitOnHang != 0);
+}
+
+extern "C" int GameManager_lastGameTimeout(char* buf, std::size_t size) {
+    if (t_lastTimeout.empty()) return 0;
+    if (buf && size > 0) std::snprintf(buf, size, "%s", t_lastTimeout.c_str());
+    t_lastTimeout.clear();
+    return 1;
+}
+
+extern "C" int GameManager_setReplayFile(const char* path) {
+    if (!path || !*path) return 0;
+    if (!replay::openContainer(path)) {
+        ERROR_PRINT("LOGMANAGER", "setReplayFile", std::string("Failed to open replay file: ") + path);
+        return 0;
+    }
+    return 1;
+}
+
 // ——————————————————————————————————————————————————————
 // MyGameManager_315634022
 // ——————————————————————————————————————————————————————
@@ -183,27 +204,25 @@ GameResult MyGameManager_315634022::run(
     {
         const Board& B = state_->getBoard();
         std::size_t p1 = 0, p2 = 0;
-        for (std::size_t y = 0; y < B.getRows(); ++y) {
-            for (std::size_t x = 0; x < B.getCols(); ++x) {
-                const auto c = B.getCell(static_cast<int>(x), static_cast<int>(y)).content;
-                if (c == CellContent::TANK1)      ++p1;
-                else if (c == CellContent::TANK2) ++p2;
-            }
-        }
+        B.countTanks(p1, p2);
         if (p1 == 0 || p2 == 0) {
             INFO_PRINT("GAMEEND", "run",
                 "Early termination BEFORE gameLoop: p1=" + std::to_string(p1) +
                 ", p2=" + std::to_string(p2) +
                 " -> reason=ALL_TANKS_DEAD, rounds=0");
             // Reuse existing finalize(): winner/reason/rounds derived consistently.
-            return finalize();
+            GameResult gr = finalize();
+            lease_.reset();
+            return gr;
         }
     }
 
 
     gameLoop();
 
-    return finalize();
+    GameResult gr = finalize();
+    lease_.reset();   // hand the arena back; drops the algorithms before we return
+    return gr;
 }
 
 void MyGameManager_315634022::prepareLog(const std::string& map_name,
@@ -211,6 +230,11 @@ void MyGameManager_315634022::prepareLog(const std::string& map_name,
                                          const std::string& algo2_name) {
     if (!verbose_) return;
     const std::string log_filename = buildLogFilename(map_name, algo1_name, algo2_name);
+    recording_ = replay::containerFd() >= 0;
+    if (recording_) {
+        replayLogName_ = log_filename;   // the record replaces the text log
+        return;
+    }
     log_file_.open(log_filename);
     if (!log_file_.is_open()) {
         ERROR_PRINT("LOGMANAGER", "prepareLog", "Failed to open log file: " + log_filename);
@@ -233,14 +257,18 @@ void MyGameManager_315634022::initializeGame(
 ) {
     INFO_PRINT("GAMEMANAGER", "initializeGame", "Initializing game with provided parameters");
 
-    // Board(rows, cols) — pass (height, width)
-    board_ = Board(height, width);
-    board_.loadFromSatelliteView(satellite_view);
-
-    state_ = std::make_unique<GameState>(
-        std::move(board_), map_name, max_steps, num_shells,
-        p1, name1, p2, name2, f1, f2, verbose_
-    );
+    lease_.emplace();
+    state_ = &lease_->state();
+    state_->reset(satellite_view, width, height, map_name, max_steps, num_shells,
+                  p1, name1, p2, name2, std::move(f1), std::move(f2), verbose_);
+    state_->setProfiling(g_profiling.load(std::memory_order_relaxed));
+    state_->setLimits(g_decisionMs.load(std::memory_order_relaxed), g_gameMs.load(std::memory_order_relaxed));
+    t_lastTimeout.clear();
+    state_->setTurnCodesOnly(recording_);
+    if (recording_) {
+        t_replay.begin(replayLogName_, map_name, name1, name2, satellite_view, height, width,
+                       max_steps, num_shells, state_->getTankCount());
+    }
 
     INFO_PRINT("GAMEMANAGER", "initializeGame", "GameState created successfully");
 }
@@ -248,8 +276,10 @@ void MyGameManager_315634022::initializeGame(
 void MyGameManager_315634022::gameLoop() {
     INFO_PRINT("GAMEMANAGER", "gameLoop", "Entering game loop");
     while (!state_->isGameOver()) {
-        std::string decisions = state_->advanceOneTurn();   // increments internally
-        if (verbose_ && log_file_.is_open()) {
+        const std::string& decisions = state_->advanceOneTurn();   // increments internally
+        if (recording_) {
+            t_replay.addTurn(state_->getTurnCodes());
+        } else if (verbose_ && log_file_.is_open()) {
             log_file_ << decisions << "\n";
             log_file_.flush();
         }
@@ -269,13 +299,7 @@ GameResult MyGameManager_315634022::finalize() {
 
     // Recount remaining tanks from the final board (source of truth)
     size_t p1 = 0, p2 = 0;
-    for (size_t y = 0; y < B.getRows(); ++y) {
-        for (size_t x = 0; x < B.getCols(); ++x) {
-            const auto c = B.getCell(static_cast<int>(x), static_cast<int>(y)).content;
-            if (c == CellContent::TANK1) ++p1;
-            else if (c == CellContent::TANK2) ++p2;
-        }
-    }
+    B.countTanks(p1, p2);
     gr.remaining_tanks = { p1, p2 };
 
     // Winner & reason
@@ -299,32 +323,48 @@ GameResult MyGameManager_315634022::finalize() {
     // Total rounds taken (turns are already incremented at end of each turn)
     gr.rounds = state_->getCurrentTurn();
 
-    // Write the exact final line to the plain log (no headers/footers)
-        // Write the exact final line to the plain log (no headers/footers).
-    // On early termination (no P1/P2 at start) resultStr_ may be empty because
-    // checkGameEndConditions() never ran; synthesize the canonical line here.
-    if (verbose_ && log_file_.is_open()) {
-        std::string finalLine = state_->getResultString();
-        if (finalLine.empty()) {
-            if (p1 == 0 && p2 == 0) {
-                finalLine = "Tie, both players have zero tanks";
-            } else if (p1 == 0) {
-                finalLine = "Player 2 won with " + std::to_string(p2) + " tanks still alive";
-            } else if (p2 == 0) {
-                finalLine = "Player 1 won with " + std::to_string(p1) + " tanks still alive";
-            }
-        }
-        if (!finalLine.empty()) {
-           log_file_ << finalLine << "\n";
-            log_file_.flush();
-        }
-        log_file_.close();
+    if (g_profiling.load(std::memory_order_relaxed)) {
+        t_lastProfile = state_->getProfile();
+        t_hasProfile  = true;
     }
+    t_lastTimeout = state_->getTimeoutNote();
+
+    writeFinalLine(p1, p2);
     // Detailed one-liner summary of the result for debugging
     DEBUG_PRINT("GAMEMANAGER", "finalize", summarizeGameResult(gr, B), verbose_);
 
     return gr;
 }
 
+// Write the exact final line to the plain log (no headers/footers), or close
+// the game's replay record with it.
+// On early termination (no P1/P2 at start) resultStr_ may be empty because
+// checkGameEndConditions() never ran; synthesize the canonical line here.
+void MyGameManager_315634022::writeFinalLine(std::size_t p1, std::size_t p2) {
+    if (!recording_ && !(verbose_ && log_file_.is_open())) return;
+    std::string finalLine = state_->getResultString();
+    if (finalLine.empty()) {
+        if (p1 == 0 && p2 == 0) {
+            finalLine = "Tie, both players have zero tanks";
+        } else if (p1 == 0) {
+            finalLine = "Player 2 won with " + std::to_string(p2) + " tanks still alive";
+        } else if (p2 == 0) {
+            finalLine = "Player 1 won with " + std::to_string(p1) + " tanks still alive";
+        }
+    }
+    if (recording_) {
+        recording_ = false;
+        if (!t_replay.finish(finalLine, replay::containerFd())) {
+            ERROR_PRINT("LOGMANAGER", "writeFinalLine", "Failed to append replay record: " + replayLogName_);
+        }
+        return;
+    }
+    if (!finalLine.empty()) {
+        log_file_ << finalLine << "\n";
+        log_file_.flush();
+    }
+    log_file_.close();
+}
+
 // Keep registration
 REGISTER_GAME_MANAGER(MyGameManager_315634022)
@@ -1,60 +1,20 @@
 // GameState.cpp
 #include "GameState.h"
 #include "MySatelliteView.h"   // for GetBattleInfo handling
+#include "Logging.h"
+#include "Replay.h"
 #include <iostream>
 #include <sstream>
-#include <mutex>
-#include <thread>
+#include <algorithm>
 
 using namespace GameManager_315634022;
 namespace { constexpr std::size_t ZERO_SHELLS_TIE_STREAK = 40; }
 
 // ——————————————————————————————————————————————————
-// Professional Debug Logging System
+// Ctor / Dtor, arena reset and simple getters
 // ——————————————————————————————————————————————————
-namespace {
-const char* actionToString(ActionRequest a) {
-    switch (a) {
-        case ActionRequest::MoveForward:    return "MoveForward";
-        case ActionRequest::MoveBackward:   return "MoveBackward";
-        case ActionRequest::RotateLeft90:   return "RotateLeft90";
-        case ActionRequest::RotateRight90:  return "RotateRight90";
-        case ActionRequest::RotateLeft45:   return "RotateLeft45";
-        case ActionRequest::RotateRight45:  return "RotateRight45";
-        case ActionRequest::Shoot:          return "Shoot";
-        case ActionRequest::GetBattleInfo:  return "GetBattleInfo";
-        case ActionRequest::DoNothing:      return "DoNothing";
-    }
-    return "Unknown";
-}
-}
-
-static std::mutex g_debug_mutex;
-
-#define DEBUG_PRINT(component, function, message, debug_flag) \
-    do { if (debug_flag) { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cout << "[T" << std::this_thread::get_id() << "] [DEBUG] [" << component \
-              << "] [" << function << "] " << message << std::endl; }} while(0)
-
-#define INFO_PRINT(component, function, message) \
-    do { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cout << "[T" << std::this_thread::get_id() << "] [INFO] [" << component \
-              << "] [" << function << "] " << message << std::endl; } while(0)
+GameState::GameState() = default;
 
-#define WARN_PRINT(component, function, message) \
-    do { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cerr << "[T" << std::this_thread::get_id() << "] [WARN] [" << component \
-              << "] [" << function << "] " << message << std::endl; } while(0)
-
-#define ERROR_PRINT(component, function, message) \
-    do { std::lock_guard<std::mutex> lock(g_debug_mutex); \
-    std::cerr << "[T" << std::this_thread::get_id() << "] [ERROR] [" << component \
-              << "] [" << function << "] " << message << std::endl; } while(0)
-
-
-// ——————————————————————————————————————————————————
-// Ctor / Dtor and simple getters (original behavior)
-// ——————————————————————————————————————————————————
 GameState::GameState(
     Board&&                board,
     std::string            map_name,
@@ -68,32 +28,119 @@ GameState::GameState(
     TankAlgorithmFactory   factory2,
     bool                   verbose
 )
-  : verbose_(verbose)
-  , board_(std::move(board))
-  , map_name_(std::move(map_name))
-  , max_steps_(max_steps)
-  , currentStep_(0)
-  , num_shells_(num_shells)
-  , gameOver_(false)
-  , resultStr_()
-  , p1_(player1)
-  , name1_(name1)
-  , p2_(player2)
-  , name2_(name2)
-  , algoFactory1_(std::move(factory1))
-  , algoFactory2_(std::move(factory2))
 {
+    rules_.board = std::move(board);
+    bindGame(map_name, max_steps, num_shells, player1, name1, player2, name2,
+             std::move(factory1), std::move(factory2), verbose);
+}
+
+void GameState::reset(
+    const SatelliteView&   map,
+    std::size_t            width,
+    std::size_t            height,
+    const std::string&     map_name,
+    std::size_t            max_steps,
+    std::size_t            num_shells,
+    Player&                player1,
+    const std::string&     name1,
+    Player&                player2,
+    const std::string&     name2,
+    TankAlgorithmFactory   factory1,
+    TankAlgorithmFactory   factory2,
+    bool                   verbose)
+{
+    rules_.board.reset(height, width);
+    rules_.board.loadFromSatelliteView(map);
+    bindGame(map_name, max_steps, num_shells, player1, name1, player2, name2,
+             std::move(factory1), std::move(factory2), verbose);
+}
+
+void GameState::releaseBindings() {
+    // Algorithms and factories live in the algorithm .so; never keep them past a game.
+    all_tank_algorithms_.clear();
+    algoFactory1_ = nullptr;
+    algoFactory2_ = nullptr;
+    p1_ = nullptr;
+    p2_ = nullptr;
+    disarmLimits();
+}
+
+// Rebinds to a freshly loaded board. Containers are cleared or re-assigned,
+// never shrunk, so a reused GameState keeps its capacity across games.
+void GameState::bindGame(const std::string& map_name, std::size_t max_steps, std::size_t num_shells,
+                         Player& player1, const std::string& name1,
+                         Player& player2, const std::string& name2,
+                         TankAlgorithmFactory factory1, TankAlgorithmFactory factory2,
+                         bool verbose)
+{
+    verbose_      = verbose;
+    map_name_     = map_name;
+    max_steps_    = max_steps;
+    num_shells_   = num_shells;
+    rules_.step             = 0;
+    rules_.gameOver         = false;
+    rules_.result.clear();
+    rules_.zeroShellsStreak = 0;
+    profile_.clear();
+    timeoutNote_.clear();
+    p1_ = &player1;  name1_ = name1;
+    p2_ = &player2;  name2_ = name2;
+    algoFactory1_ = std::move(factory1);
+    algoFactory2_ = std::move(factory2);
+
     INFO_PRINT("GAMESTATE", "constructor", "Initializing GameState");
     DEBUG_PRINT("GAMESTATE", "constructor",
         "Parameters - Map: " + map_name_ +
         ", MaxSteps: " + std::to_string(max_steps_) +
         ", NumShells: " + std::to_string(num_shells_), verbose_);
 
-    // --- Initialize tanks from board ---
-    rows_ = board_.getRows();
-    cols_ = board_.getCols();
+    scanTanks();
+    createTankAlgorithms();
+
+    // Initialize game state containers
+    rules_.shells.clear();
+    cellShellHead_.assign(rows_ * cols_, -1);
+    cellVisits_.assign(rows_ * cols_, 0);
+    destCount_.assign(rows_ * cols_, 0);
+    indexedCells_.clear();
+    visitLog_.clear();
+    reserveTurnScratch();
+
+    INFO_PRINT("GAMESTATE", "constructor", "GameState initialization completed successfully");
+}
+
+// Size every per-turn buffer up front. Live shells never exceed the number
+// fired, and two shells cannot share a cell past a turn, so min(fired, cells)
+// bounds them; each shell lands at most twice per turn.
+void GameState::reserveTurnScratch() {
+    const std::size_t N = rules_.tanks.size();
+    const std::size_t maxShells = std::min(N * num_shells_ + N, rows_ * cols_ + N);
+
+    actions_.reserve(N);
+    logActions_.reserve(N);
+    ignored_.resize(N);
+    killed_.resize(N);
+    tankOldPos_.reserve(N);
+    tankNewPos_.reserve(N);
+    movers_.reserve(N);
+
+    rules_.shells.reserve(maxShells);
+    shellPos_.reserve(maxShells);
+    shellDelta_.reserve(maxShells);
+    shellNext_.reserve(maxShells);
+    indexedCells_.reserve(maxShells);
+    visitLog_.reserve(2 * maxShells);
+    turnCodes_.reserve(N);
+    turnLog_.reserve(N * 24);
+}
+
+void GameState::scanTanks() {
+    rows_ = rules_.board.getRows();
+    cols_ = rules_.board.getCols();
     nextTankIndex_[1] = nextTankIndex_[2] = 0;
-    tankIdMap_.assign(3, std::vector<std::size_t>(rows_*cols_, SIZE_MAX));
+    rules_.tanks.clear();
+    tankIdMap_.resize(3);
+    for (auto& ids : tankIdMap_) ids.assign(rows_ * cols_, SIZE_MAX);
 
     DEBUG_PRINT("GAMESTATE", "constructor",
         "Board dimensions: " + std::to_string(cols_) + "x" + std::to_string(rows_), verbose_);
@@ -102,7 +149,7 @@ GameState::GameState(
 
     for (std::size_t r = 0; r < rows_; ++r) {
         for (std::size_t c = 0; c < cols_; ++c) {
-            const auto& cell = board_.getCell(int(c), int(r));
+            const auto& cell = rules_.board.getCell(int(c), int(r));
             if (cell.content == CellContent::TANK1 || cell.content == CellContent::TANK2) {
                 int pidx = (cell.content == CellContent::TANK1 ? 1 : 2);
                 int tidx = nextTankIndex_[pidx]++;
@@ -120,8 +167,8 @@ GameState::GameState(
                     /*lastActionBack*/ false
                 };
 
-                all_tanks_.push_back(ts);
-                tankIdMap_[pidx][tidx] = all_tanks_.size()-1;
+                rules_.tanks.push_back(ts);
+                tankIdMap_[pidx][tidx] = rules_.tanks.size()-1;
 
                 DEBUG_PRINT("TANKMANAGER", "constructor",
                     "Tank discovered - Player " + std::to_string(pidx) +
@@ -132,14 +179,15 @@ GameState::GameState(
     }
 
     INFO_PRINT("TANKMANAGER", "constructor",
-        "Tank scan complete - Found " + std::to_string(all_tanks_.size()) + " tanks total");
+        "Tank scan complete - Found " + std::to_string(rules_.tanks.size()) + " tanks total");
+}
 
-    // --- Create per‐tank algorithms ---
+void GameState::createTankAlgorithms() {
     all_tank_algorithms_.clear();
     DEBUG_PRINT("ALGOMANAGER", "constructor", "Starting algorithm creation for all tanks", verbose_);
 
-    for (size_t i = 0; i < all_tanks_.size(); ++i) {
-        auto& ts = all_tanks_[i];
+    for (size_t i = 0; i < rules_.tanks.size(); ++i) {
+        auto& ts = rules_.tanks[i];
         DEBUG_PRINT("ALGOMANAGER", "constructor",
             "Creating algorithm for Tank " + std::to_string(i) +
             " (Player " + std::to_string(ts.player_index) +
@@ -190,87 +238,62 @@ GameState::GameState(
         DEBUG_PRINT("ALGOMANAGER", "constructor",
             "Algorithm " + std::to_string(i) + " verified valid", verbose_);
     }
-
-    // Initialize game state containers
-    shells_.clear();
-    toRemove_.clear();
-    positionMap_.clear();
-
-    INFO_PRINT("GAMESTATE", "constructor", "GameState initialization completed successfully");
 }
 
-GameState::~GameState() = default;
+GameState::~GameState() {
+    disarmLimits();
+}
 
-bool GameState::isGameOver() const { return gameOver_; }
-std::string GameState::getResultString() const { return resultStr_; }
-std::size_t GameState::getCurrentTurn() const { return currentStep_; }
-const Board& GameState::getBoard() const { return board_; }
+bool GameState::isGameOver() const { return rules_.gameOver; }
+std::string GameState::getResultString() const { return rules_.result; }
+std::size_t GameState::getCurrentTurn() const { return rules_.step; }
+const Board& GameState::getBoard() const { return rules_.board; }
 
 
 // === extracted helpers implementations ===
 void GameState::logTurnStart(std::size_t N) {
-    DEBUG_PRINT("GAMELOOP", "advanceOneTurn",
-        "Starting turn " + std::to_string(currentStep_ + 1) +
-        " with " + std::to_string(N) + " tanks", verbose_);
-    INFO_PRINT("ACTIONGATHER", "advanceOneTurn", "Gathering action requests from all tanks");
+    TRACE_PRINT("GAMELOOP", "advanceOneTurn",
+        "Starting turn " + std::to_string(rules_.step + 1) +
+        " with " + std::to_string(N) + " tanks");
+    TRACE_PRINT("ACTIONGATHER", "advanceOneTurn", "Gathering action requests from all tanks");
 }
 
 void GameState::gatherActionRequests(std::vector<ActionRequest>& actions,
-                                     std::vector<bool>& ignored) {
-    const size_t N = all_tanks_.size();
+                                     DynamicBitset& ignored) {
+    const size_t N = rules_.tanks.size();
     for (size_t k = 0; k < N; ++k) {
-        auto& ts  = all_tanks_[k];
+        auto& ts  = rules_.tanks[k];
         if (!ts.alive) continue;
         auto& alg = *all_tank_algorithms_[k];
-        ActionRequest req = alg.getAction();
-        DEBUG_PRINT("ACTIONGATHER", "advanceOneTurn",
-            "Tank " + std::to_string(k) + " requested: " + actionToString(req), verbose_);
+        ActionRequest req = timedAlgorithmCall(ts.player_index, [&] { return alg.getAction(); });
+        if (decisionOverran()) {
+            forfeitTank(k);
+            continue;
+        }
+        TRACE_PRINT("ACTIONGATHER", "advanceOneTurn",
+            "Tank " + std::to_string(k) + " requested: " + replay::actionName(req));
 
         if (req == ActionRequest::GetBattleInfo) {
-            INFO_PRINT("BATTLEINFO", "advanceOneTurn",
+            TRACE_PRINT("BATTLEINFO", "advanceOneTurn",
                 "Tank " + std::to_string(k) + " requested battle info");
 
-            // Build visibility snapshot (like original)
-            std::vector<std::vector<char>> grid(rows_, std::vector<char>(cols_, ' '));
-            for (size_t yy = 0; yy < rows_; ++yy) {
-                for (size_t xx = 0; xx < cols_; ++xx) {
-                    const auto& cell = board_.getCell(int(xx), int(yy));
-                    grid[yy][xx] = (cell.content==CellContent::WALL ? '#' :
-                        cell.content==CellContent::MINE ? '@' :
-                        cell.content==CellContent::TANK1 ? '1' :
-                        cell.content==CellContent::TANK2 ? '2' : ' ');
-                }
-            }
-            if (ts.y >= 0 && ts.y < static_cast<int>(rows_) &&
-                ts.x >= 0 && ts.x < static_cast<int>(cols_)) {
-                grid[ts.y][ts.x] = '%';
-            }
-
-            DEBUG_PRINT("BATTLEINFO", "advanceOneTurn",
+            // Zero-copy view over the live board with this tank marked '%'
+            TRACE_PRINT("BATTLEINFO", "advanceOneTurn",
                 "Creating MySatelliteView for Tank " + std::to_string(k) +
-                " at (" + std::to_string(ts.x) + "," + std::to_string(ts.y) + ")", verbose_);
-
-            MySatelliteView view(grid, rows_, cols_, ts.x, ts.y);
-
-            char** test_grid = view.getGrid();
-            if (test_grid == nullptr) {
-                ERROR_PRINT("BATTLEINFO", "advanceOneTurn",
-                    "MySatelliteView returned null grid pointer for Tank " + std::to_string(k));
-            } else if (test_grid[0] == nullptr) {
-                ERROR_PRINT("BATTLEINFO", "advanceOneTurn",
-                    "MySatelliteView first row is null for Tank " + std::to_string(k));
-            } else {
-                DEBUG_PRINT("BATTLEINFO", "advanceOneTurn",
-                    "MySatelliteView validation successful for Tank " + std::to_string(k), verbose_);
+                " at (" + std::to_string(ts.x) + "," + std::to_string(ts.y) + ")");
+            MySatelliteView view(rules_.board, ts.x, ts.y);
+
+            TRACE_PRINT("BATTLEINFO", "advanceOneTurn",
+                "Updating tank with battle info via player interface");
+            Player& owner = (ts.player_index == 1) ? *p1_ : *p2_;
+            timedAlgorithmCall(ts.player_index, [&] { owner.updateTankWithBattleInfo(alg, view); });
+            if (decisionOverran()) {
+                forfeitTank(k);
+                continue;
             }
 
-            DEBUG_PRINT("BATTLEINFO", "advanceOneTurn",
-                "Updating tank with battle info via player interface", verbose_);
-            if (ts.player_index == 1) p1_.updateTankWithBattleInfo(alg, view);
-            else                       p2_.updateTankWithBattleInfo(alg, view);
-
-            DEBUG_PRINT("BATTLEINFO", "advanceOneTurn",
-                "Tank " + std::to_string(k) + " battle info update completed", verbose_);
+            TRACE_PRINT("BATTLEINFO", "advanceOneTurn",
+                "Tank " + std::to_string(k) + " battle info update completed");
             actions[k] = ActionRequest::GetBattleInfo;
             ignored[k] = false;
         } else {
@@ -280,30 +303,31 @@ void GameState::gatherActionRequests(std::vector<ActionRequest>& actions,
 }
 
 void GameState::executePhases(std::vector<ActionRequest>& actions,
-                              std::vector<bool>& ignored,
-                              std::vector<bool>& killed) {
+                              DynamicBitset& ignored,
+                              DynamicBitset& killed) {
     // ORIGINAL ORDER — do not change
-    DEBUG_PRINT("GAMELOOP", "advanceOneTurn",
-        "Executing game phases for turn " + std::to_string(currentStep_ + 1), verbose_);
+    TRACE_PRINT("GAMELOOP", "advanceOneTurn",
+        "Executing game phases for turn " + std::to_string(rules_.step + 1));
         
     // Phase 1: Apply rotations and handle mine collisions
-    DEBUG_PRINT("GAMELOOP", "advanceOneTurn", "Phase 1: Applying rotations and handling mine collisions", verbose_);
-    applyTankRotations(actions);
-    handleTankMineCollisions();
-    updateTankCooldowns();
-    confirmBackwardMoves(ignored, actions);
-    updateShellsWithOverrunCheck();
-    resolveShellCollisions();
-    handleShooting(ignored, actions);
-    updateTankPositionsOnBoard(ignored, killed, actions);
-    filterRemainingShells();
-    cleanupDestroyedEntities();
-    checkGameEndConditions();
-    DEBUG_PRINT("GAMELOOP", "advanceOneTurn",
-        "Game phases executed successfully for turn " + std::to_string(currentStep_ + 1), verbose_);
-}
-
-void GameState::handleShooting(std::vector<bool>& ignored,
+    TRACE_PRINT("GAMELOOP", "advanceOneTurn", "Phase 1: Applying rotations and handling mine collisions");
+    GameProfile* prof = activeProfile();
+    { GM_PHASE_SCOPE(prof, Phase::Rotations);     applyTankRotations(actions); }
+    { GM_PHASE_SCOPE(prof, Phase::MineHits);      handleTankMineCollisions(); }
+    { GM_PHASE_SCOPE(prof, Phase::Cooldowns);     updateTankCooldowns(); }
+    { GM_PHASE_SCOPE(prof, Phase::BackwardMoves); confirmBackwardMoves(ignored, actions); }
+    { GM_PHASE_SCOPE(prof, Phase::ShellMoves);    updateShellsWithOverrunCheck(); }
+    { GM_PHASE_SCOPE(prof, Phase::ShellHits);     resolveShellCollisions(); }
+    { GM_PHASE_SCOPE(prof, Phase::Shooting);      handleShooting(ignored, actions); }
+    { GM_PHASE_SCOPE(prof, Phase::TankMoves);     updateTankPositionsOnBoard(ignored, killed, actions); }
+    { GM_PHASE_SCOPE(prof, Phase::ShellFilter);   filterRemainingShells(); }
+    { GM_PHASE_SCOPE(prof, Phase::Cleanup);       cleanupDestroyedEntities(); }
+    { GM_PHASE_SCOPE(prof, Phase::EndCheck);      checkGameEndConditions(); }
+    TRACE_PRINT("GAMELOOP", "advanceOneTurn",
+        "Game phases executed successfully for turn " + std::to_string(rules_.step + 1));
+}
+
+void GameState::handleShooting(DynamicBitset& ignored,
                                const std::vector<ActionRequest>& A)
 {
     auto spawn = [&](TankState& ts){
@@ -314,14 +338,14 @@ void GameState::handleShooting(std::vector<bool>& ignored,
         case 4: dy=1; break;  case 5: dx=-1;dy=1; break;
         case 6: dx=-1; break; case 7: dx=-1;dy=-1; break;
         }
-        int sx=(ts.x+dx+board_.getWidth())%board_.getWidth();
-        int sy=(ts.y+dy+board_.getHeight())%board_.getHeight();
+        int sx=(ts.x+dx+rules_.board.getWidth())%rules_.board.getWidth();
+        int sy=(ts.y+dy+rules_.board.getHeight())%rules_.board.getHeight();
         if (!handleShellMidStepCollision(sx,sy))
-            shells_.push_back({sx,sy,ts.direction});
+            rules_.shells.push_back({sx,sy,ts.direction});
     };
 
-    for (size_t k = 0; k < all_tanks_.size(); ++k) {
-        auto& ts = all_tanks_[k];
+    for (size_t k = 0; k < rules_.tanks.size(); ++k) {
+        auto& ts = rules_.tanks[k];
         if (!ts.alive || A[k] != ActionRequest::Shoot) continue;
 
         // 1) still cooling down?
@@ -335,63 +359,34 @@ void GameState::handleShooting(std::vector<bool>& ignored,
     }
 }
 
-std::string GameState::buildTurnLogString(const std::vector<ActionRequest>& logActions,
-                                          const std::vector<bool>& ignored,
-                                          const std::vector<bool>& killed) const {
-    (void)killed; // suppress unused parameter warning (no behavior change)
-    const size_t N = all_tanks_.size();
-    std::ostringstream oss;
+// One code per tank (what the text log shows for it), then the text line
+// unless only codes are recorded.
+void GameState::buildTurnLog(const std::vector<ActionRequest>& logActions,
+                             const DynamicBitset& ignored) {
+    const size_t N = rules_.tanks.size();
+    turnCodes_.resize(N);
     for (size_t k = 0; k < N; ++k) {
         const auto act = logActions[k];
-        const char* name = actionToString(act);
-        if (all_tanks_[k].alive) {
-            oss << name;
-            if (ignored[k] && act != ActionRequest::GetBattleInfo) {
-                oss << " (ignored)";
-            }
-        } else {
-            if (act == ActionRequest::DoNothing) oss << "killed";
-            else oss << name << " (killed)";
-        }
-        if (k + 1 < N) oss << ", ";
-    }
-    return oss.str();
-}
-
-// std::string GameState::renderRow(std::size_t r) const {
-//     std::ostringstream line;
-//     for (size_t c = 0; c < cols_; ++c) {
-//         bool shellHere = false;
-//         for (const auto& sh : shells_) {
-//             if (sh.x == int(c) && sh.y == int(r)) { shellHere = true; break; }
-//         }
-//         if (shellHere) { line << '*'; continue; }
-//         const auto& cell = board_.getCell(int(c), int(r));
-//         switch (cell.content) {
-//             case CellContent::EMPTY: line << '_'; break;
-//             case CellContent::WALL:  line << '#'; break;
-//             case CellContent::MINE:  line << '@'; break;
-//             case CellContent::TANK1:
-//             case CellContent::TANK2: {
-//                 line << tankArrowAt(r, c);
-//                 break;
-//             }
-//             default: line << '?'; break;
-//         }
-//     }
-//     return line.str();
-// }
+        replay::TankMark mark = replay::Plain;
+        if (!rules_.tanks[k].alive) mark = replay::Killed;
+        else if (ignored[k] && act != ActionRequest::GetBattleInfo) mark = replay::Ignored;
+        turnCodes_[k] = replay::tankCode(act, mark);
+    }
+
+    turnLog_.clear();
+    if (turnCodesOnly_) return;
+    for (size_t k = 0; k < N; ++k) {
+        replay::appendTankEntry(turnLog_, turnCodes_[k]);
+        if (k + 1 < N) turnLog_ += ", ";
+    }
+}
 
 std::string GameState::renderRow(std::size_t r) const {
     std::ostringstream line;
     for (size_t c = 0; c < cols_; ++c) {
-        bool shellHere = false;
-        for (const auto& sh : shells_) {
-            if (sh.x == int(c) && sh.y == int(r)) { shellHere = true; break; }
-        }
-        if (shellHere) { line << '*'; continue; }
+        const auto& cell = rules_.board.getCell(int(c), int(r));
+        if (cell.hasShellOverlay) { line << '*'; continue; }
 
-        const auto& cell = board_.getCell(int(c), int(r));
         switch (cell.content) {
             case CellContent::EMPTY: line << ' '; break;     // <— space, not underscore
             case CellContent::WALL:  line << '#'; break;
@@ -410,7 +405,7 @@ std::string GameState::renderRow(std::size_t r) const {
 
 std::string GameState::tankArrowAt(std::size_t r, std::size_t c) const {
     int pid = 0, dir = 0;
-    for (auto const& ts : all_tanks_) {
+    for (auto const& ts : rules_.tanks) {
         if (ts.alive && ts.x == int(c) && ts.y == int(r)) {
             pid = ts.player_index;
             dir = ts.direction;
@@ -423,11 +418,18 @@ std::string GameState::tankArrowAt(std::size_t r, std::size_t c) const {
     return out.str();
 }
 
-std::vector<std::pair<int,int>> GameState::computeShellDeltas() const {
-    std::vector<std::pair<int,int>> delta(shells_.size());
-    for (size_t i = 0; i < shells_.size(); ++i) {
+int GameState::tankDirectionAt(int x, int y) const {
+    for (auto const& ts : rules_.tanks) {
+        if (ts.alive && ts.x == x && ts.y == y) return ts.direction;
+    }
+    return -1;
+}
+
+void GameState::computeShellDeltas(std::vector<std::pair<int,int>>& delta) const {
+    delta.resize(rules_.shells.size());
+    for (size_t i = 0; i < rules_.shells.size(); ++i) {
         int dx = 0, dy = 0;
-        switch (shells_[i].dir) {
+        switch (rules_.shells[i].dir) {
           case 0:  dy = -1; break;
           case 1:  dx = +1; dy = -1; break;
           case 2:  dx = +1; break;
@@ -439,40 +441,69 @@ std::vector<std::pair<int,int>> GameState::computeShellDeltas() const {
         }
         delta[i] = {dx, dy};
     }
-    return delta;
 }
 
 void GameState::processShellHalfStep(const std::vector<std::pair<int,int>>& delta,
                                      const std::vector<std::pair<int,int>>& oldPos,
                                      int /*step*/) {
-    for (size_t i = 0; i < shells_.size(); ++i) {
-        if (toRemove_.count(i)) continue;
-        int nx = shells_[i].x + delta[i].first;
-        int ny = shells_[i].y + delta[i].second;
-        board_.wrapCoords(nx, ny);
-
-        for (size_t j = 0; j < shells_.size(); ++j) {
-            if (i == j || toRemove_.count(j)) continue;
-            auto [oxj, oyj] = oldPos[j];
-            int nxj = oxj + delta[j].first;
-            int nyj = oyj + delta[j].second;
-            board_.wrapCoords(nxj, nyj);
-            if (nx == oxj && ny == oyj && nxj == oldPos[i].first && nyj == oldPos[i].second) {
-                toRemove_.insert(i);
-                toRemove_.insert(j);
+    // cellShellHead_ indexes shells by their position at the start of the turn
+    for (size_t i = 0; i < rules_.shells.size(); ++i) {
+        if (rules_.shells[i].fate != ShellFate::Live) continue;
+        int nx = rules_.shells[i].x + delta[i].first;
+        int ny = rules_.shells[i].y + delta[i].second;
+        rules_.board.wrapCoords(nx, ny);
+
+        // swap: a shell that started where i is heading, and heads where i started
+        for (int j = cellShellHead_[rules_.board.index(nx, ny)]; j != -1; j = shellNext_[j]) {
+            if (size_t(j) == i || rules_.shells[j].fate != ShellFate::Live) continue;
+            int nxj = oldPos[j].first  + delta[j].first;
+            int nyj = oldPos[j].second + delta[j].second;
+            rules_.board.wrapCoords(nxj, nyj);
+            if (nxj == oldPos[i].first && nyj == oldPos[i].second) {
+                rules_.shells[i].fate = ShellFate::Destroyed;
+                rules_.shells[j].fate = ShellFate::Destroyed;
             }
         }
-        if (toRemove_.count(i)) continue;
-        shells_[i].x = nx;
-        shells_[i].y = ny;
+        if (rules_.shells[i].fate != ShellFate::Live) continue;
+        rules_.shells[i].x = nx;
+        rules_.shells[i].y = ny;
         if (handleShellMidStepCollision(nx, ny)) {
-            toRemove_.insert(i);
+            rules_.shells[i].fate = ShellFate::Destroyed;
             continue;
         }
-        positionMap_[{nx, ny}].push_back(i);
+        recordShellVisit(nx, ny, i);
     }
 }
 
+// Chains every shell into the cell given by pos[i]; chains run in ascending id order.
+void GameState::indexShellsAt(const std::vector<std::pair<int,int>>& pos) {
+    shellNext_.resize(pos.size());
+    for (size_t i = pos.size(); i-- > 0;) {
+        const size_t cell = rules_.board.index(pos[i].first, pos[i].second);
+        if (cellShellHead_[cell] == -1) indexedCells_.push_back(cell);
+        shellNext_[i] = cellShellHead_[cell];
+        cellShellHead_[cell] = int(i);
+    }
+}
+
+void GameState::clearShellIndex() {
+    for (size_t cell : indexedCells_) cellShellHead_[cell] = -1;
+    indexedCells_.clear();
+}
+
+int GameState::firstUnconsumedShellAt(int x, int y) const {
+    for (int s = cellShellHead_[rules_.board.index(x, y)]; s != -1; s = shellNext_[s]) {
+        if (rules_.shells[s].fate != ShellFate::Consumed) return s;
+    }
+    return -1;
+}
+
+void GameState::recordShellVisit(int x, int y, std::size_t shell) {
+    const size_t cell = rules_.board.index(x, y);
+    ++cellVisits_[cell];
+    visitLog_.emplace_back(cell, shell);
+}
+
 // give nice arrows for 8 directions
 const char* GameState::directionToArrow(int dir) {
     static const char* arr[8] = {"↑","↗","→","↘","↓","↙","←","↖"};
@@ -480,61 +511,75 @@ const char* GameState::directionToArrow(int dir) {
 }
 
 
-std::string GameState::advanceOneTurn() {
-    if (gameOver_) {
-        DEBUG_PRINT("GAMELOOP", "advanceOneTurn", "Game already over, returning empty string", verbose_);
-        return "";
+const std::string& GameState::advanceOneTurn() {
+    if (rules_.gameOver) {
+        TRACE_PRINT("GAMELOOP", "advanceOneTurn", "Game already over, returning empty string");
+        turnCodes_.clear();
+        turnLog_.clear();
+        return turnLog_;
     }
 
-    const size_t N = all_tanks_.size();
-    std::vector<ActionRequest> actions(N, ActionRequest::DoNothing);
-    std::vector<bool> ignored(N, false), killed(N, false);
+    // Per-turn scratch lives in members sized in bindGame(); no allocation here.
+    const size_t N = rules_.tanks.size();
+    actions_.assign(N, ActionRequest::DoNothing);
+    ignored_.reset();
+    killed_.reset();
 
     logTurnStart(N);
-    gatherActionRequests(actions, ignored);
+    if (limited_ && watch_.gameExpired.load(std::memory_order_relaxed)) forfeitOnGameBudget();
+    {
+        GM_PHASE_SCOPE(activeProfile(), Phase::Gather);
+        gatherActionRequests(actions_, ignored_);
+    }
 
     // Snapshot original actions for logging
-    std::vector<ActionRequest> logActions = actions;
+    logActions_.assign(actions_.begin(), actions_.end());
 
     // Execute the per-turn phases (original order includes checkGameEndConditions)
-    executePhases(actions, ignored, killed);
+    executePhases(actions_, ignored_, killed_);
 
     // 🔧 Restore: advance step counter and drop shoot cooldowns AFTER phases
-    ++currentStep_;
-    for (auto& ts : all_tanks_) {
+    ++rules_.step;
+    if (profiling_) ++profile_.turns;
+    for (auto& ts : rules_.tanks) {
         if (ts.shootCooldown > 0) --ts.shootCooldown;
     }
 
-    INFO_PRINT("TURNREPORT", "advanceOneTurn", "=== Current Board State ===");
-    printBoard();
+    if (GM_LOG_ENABLED(TRACE)) {
+        TRACE_PRINT("TURNREPORT", "advanceOneTurn", "=== Current Board State ===");
+        printBoard();
+    }
 
     // Build turn result string
-    std::string result = buildTurnLogString(logActions, ignored, killed);
-    DEBUG_PRINT("GAMELOOP", "advanceOneTurn", "Turn log: " + result, verbose_);
-    return result;
+    buildTurnLog(logActions_, ignored_);
+    TRACE_PRINT("GAMELOOP", "advanceOneTurn", "Turn log: " + turnLog_);
+    return turnLog_;
 }
 
 
 
 void GameState::updateShellsWithOverrunCheck() {
-    toRemove_.clear();
-    positionMap_.clear();
-    board_.clearShellMarks();
+    rules_.board.clearShellMarks();
 
-    const size_t S = shells_.size();
-    std::vector<std::pair<int,int>> oldPos(S);
-    for (size_t i = 0; i < S; ++i) oldPos[i] = { shells_[i].x, shells_[i].y };
+    const size_t S = rules_.shells.size();
+    shellPos_.resize(S);
+    for (size_t i = 0; i < S; ++i) shellPos_[i] = { rules_.shells[i].x, rules_.shells[i].y };
 
-    const auto delta = computeShellDeltas();
-    for (int step = 0; step < 2; ++step) processShellHalfStep(delta, oldPos, step);
+    computeShellDeltas(shellDelta_);
+    indexShellsAt(shellPos_);
+    for (int step = 0; step < 2; ++step) processShellHalfStep(shellDelta_, shellPos_, step);
+    clearShellIndex();
 }
 
 void GameState::printBoard() const {
-    // overlay shells & tanks dynamically in renderRow()
+    // overlay shells & tanks dynamically in renderRow(); one locked write per board
+    std::string block;
     for (size_t r = 0; r < rows_; ++r) {
-        std::cout << renderRow(r) << "\n";
+        block += renderRow(r);
+        block += '\n';
     }
-    std::cout << std::endl;
+    block += '\n';
+    logging::writeBlock(block);
 }
 
 
@@ -542,9 +587,9 @@ void GameState::printBoard() const {
 // Original mechanics broken out as separate methods
 // ——————————————————————————————————————————————————
 void GameState::applyTankRotations(const std::vector<ActionRequest>& A) {
-    for (size_t k=0; k<all_tanks_.size(); ++k) {
-        if (!all_tanks_[k].alive) continue;
-        int& d = all_tanks_[k].direction;
+    for (size_t k=0; k<rules_.tanks.size(); ++k) {
+        if (!rules_.tanks[k].alive) continue;
+        int& d = rules_.tanks[k].direction;
         switch(A[k]) {
         case ActionRequest::RotateLeft90:  d=(d+6)&7; break;
         case ActionRequest::RotateRight90: d=(d+2)&7; break;
@@ -556,12 +601,11 @@ void GameState::applyTankRotations(const std::vector<ActionRequest>& A) {
 }
 
 void GameState::handleTankMineCollisions() {
-    for (auto& ts: all_tanks_) {
+    for (auto& ts: rules_.tanks) {
         if (!ts.alive) continue;
-        auto& cell = board_.getCell(ts.x, ts.y);
-        if (cell.content==CellContent::MINE) {
+        if (rules_.board.getCell(ts.x, ts.y).content==CellContent::MINE) {
             ts.alive = false;
-            cell.content = CellContent::EMPTY;
+            rules_.board.removeContent(ts.x, ts.y);
         }
     }
 }
@@ -570,15 +614,15 @@ void GameState::updateTankCooldowns() {
     // unused in original
 }
 
-void GameState::confirmBackwardMoves(std::vector<bool>& ignored,
+void GameState::confirmBackwardMoves(DynamicBitset& ignored,
                                      const std::vector<ActionRequest>& A)
 {
-    for (size_t k = 0; k < all_tanks_.size(); ++k) {
-        if (!all_tanks_[k].alive || A[k] != ActionRequest::MoveBackward)
+    for (size_t k = 0; k < rules_.tanks.size(); ++k) {
+        if (!rules_.tanks[k].alive || A[k] != ActionRequest::MoveBackward)
             continue;
 
         // compute backward direction
-        int back = (all_tanks_[k].direction + 4) & 7;
+        int back = (rules_.tanks[k].direction + 4) & 7;
         int dx = 0, dy = 0;
         switch (back) {
         case 0: dy = -1; break;
@@ -591,32 +635,35 @@ void GameState::confirmBackwardMoves(std::vector<bool>& ignored,
         case 7: dx = -1; dy = -1; break;
         }
 
-        int nx = all_tanks_[k].x + dx;
-        int ny = all_tanks_[k].y + dy;
+        int nx = rules_.tanks[k].x + dx;
+        int ny = rules_.tanks[k].y + dy;
         // wrap around
-        board_.wrapCoords(nx, ny);
+        rules_.board.wrapCoords(nx, ny);
         // illegal if there's a wall after wrapping
-        if (board_.getCell(nx, ny).content == CellContent::WALL) {
+        if (rules_.board.getCell(nx, ny).content == CellContent::WALL) {
             ignored[k] = true;
         }
     }
 }
 
 // move + collisions (original logic)
-void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
-                                           std::vector<bool>& killedThisTurn,
+void GameState::updateTankPositionsOnBoard(DynamicBitset& ignored,
+                                           DynamicBitset& killedThisTurn,
                                            const std::vector<ActionRequest>& actions)
 {
-    board_.clearTankMarks();
+    rules_.board.clearTankMarks();
 
-    const size_t N = all_tanks_.size();
-    std::vector<std::pair<int,int>> oldPos(N), newPos(N);
+    const size_t N = rules_.tanks.size();
+    auto& oldPos = tankOldPos_;
+    auto& newPos = tankNewPos_;
+    oldPos.resize(N);
+    newPos.resize(N);
 
     // 1) compute oldPos & newPos (with wrapping)
     for (size_t k = 0; k < N; ++k) {
-        oldPos[k] = { all_tanks_[k].x, all_tanks_[k].y };
+        oldPos[k] = { rules_.tanks[k].x, rules_.tanks[k].y };
 
-        if (!all_tanks_[k].alive
+        if (!rules_.tanks[k].alive
          || ignored[k]
          || (actions[k] != ActionRequest::MoveForward
           && actions[k] != ActionRequest::MoveBackward))
@@ -626,7 +673,7 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
         }
 
         // figure out dx,dy
-        int dir = all_tanks_[k].direction;
+        int dir = rules_.tanks[k].direction;
         if (actions[k] == ActionRequest::MoveBackward)
             dir = (dir + 4) & 7;
 
@@ -642,13 +689,13 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
         case 7: dx = -1; dy = -1; break;
         }
 
-        int nx = all_tanks_[k].x + dx;
-        int ny = all_tanks_[k].y + dy;
+        int nx = rules_.tanks[k].x + dx;
+        int ny = rules_.tanks[k].y + dy;
         // wrap around the board edges
-        board_.wrapCoords(nx, ny);
+        rules_.board.wrapCoords(nx, ny);
 
         // if after wrapping there's a wall, treat as ignored
-        if (board_.getCell(nx, ny).content == CellContent::WALL) {
+        if (rules_.board.getCell(nx, ny).content == CellContent::WALL) {
             newPos[k] = oldPos[k];
             ignored[k] = true;
         } else {
@@ -659,153 +706,149 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
     // 2a) Head-on swaps: two tanks exchanging places → both die
     for (std::size_t i = 0; i < N; ++i) {
       for (std::size_t j = i+1; j < N; ++j) {
-        if (!all_tanks_[i].alive || !all_tanks_[j].alive) continue;
+        if (!rules_.tanks[i].alive || !rules_.tanks[j].alive) continue;
         if (killedThisTurn[i] || killedThisTurn[j])        continue;
         if (newPos[i] == oldPos[j] && newPos[j] == oldPos[i]) {
           killedThisTurn[i] = killedThisTurn[j] = true;
-          all_tanks_[i].alive = all_tanks_[j].alive = false;
-          board_.setCell(oldPos[i].first, oldPos[i].second, CellContent::EMPTY);
-          board_.setCell(oldPos[j].first, oldPos[j].second, CellContent::EMPTY);
+          rules_.tanks[i].alive = rules_.tanks[j].alive = false;
+          rules_.board.setCell(oldPos[i].first, oldPos[i].second, CellContent::EMPTY);
+          rules_.board.setCell(oldPos[j].first, oldPos[j].second, CellContent::EMPTY);
         }
       }
     }
 
     // 2b) Moving-into-stationary
     for (std::size_t k = 0; k < N; ++k) {
-      if (!all_tanks_[k].alive) continue;
+      if (!rules_.tanks[k].alive) continue;
       if (killedThisTurn[k])    continue;
       if (newPos[k] == oldPos[k]) continue;
       for (std::size_t j = 0; j < N; ++j) {
         if (j == k) continue;
-        if (!all_tanks_[j].alive) continue;
+        if (!rules_.tanks[j].alive) continue;
         if (killedThisTurn[j])    continue;
         if (newPos[j] != oldPos[j]) continue;
         if (newPos[k] == oldPos[j]) {
           killedThisTurn[k] = killedThisTurn[j] = true;
-          all_tanks_[k].alive = all_tanks_[j].alive = false;
-          board_.setCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
-          board_.setCell(oldPos[j].first, oldPos[j].second, CellContent::EMPTY);
+          rules_.tanks[k].alive = rules_.tanks[j].alive = false;
+          rules_.board.setCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
+          rules_.board.setCell(oldPos[j].first, oldPos[j].second, CellContent::EMPTY);
         }
       }
     }
 
     // 2c) Multi-tank collisions at same destination
-    std::map<std::pair<int,int>, std::vector<std::size_t>> destMap;
+    // (dense per-cell mover counts, reset through the movers list)
+    movers_.clear();
     for (std::size_t k = 0; k < N; ++k) {
-      if (!all_tanks_[k].alive || killedThisTurn[k] || newPos[k] == oldPos[k]) continue;
-      destMap[newPos[k]].push_back(k);
-    }
-    for (auto const& [pos, vec] : destMap) {
-      if (vec.size() > 1) {
-        for (auto k : vec) {
-          if (!all_tanks_[k].alive || killedThisTurn[k]) continue;
-          killedThisTurn[k]   = true;
-          all_tanks_[k].alive = false;
-          board_.setCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
-        }
-      }
+      if (!rules_.tanks[k].alive || killedThisTurn[k] || newPos[k] == oldPos[k]) continue;
+      movers_.push_back(k);
+      ++destCount_[rules_.board.index(newPos[k].first, newPos[k].second)];
+    }
+    for (auto k : movers_) {
+      if (destCount_[rules_.board.index(newPos[k].first, newPos[k].second)] < 2) continue;
+      killedThisTurn[k]   = true;
+      rules_.tanks[k].alive = false;
+      rules_.board.setCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
     }
+    for (auto k : movers_) destCount_[rules_.board.index(newPos[k].first, newPos[k].second)] = 0;
 
     // 3) Apply non-colliding moves
+    bool shellsIndexed = false;
     for (std::size_t k = 0; k < N; ++k) {
-        if (!all_tanks_[k].alive) continue;
+        if (!rules_.tanks[k].alive) continue;
 
         auto [ox, oy] = oldPos[k];
         auto [nx, ny] = newPos[k];
 
         // stayed in place?
         if (nx == ox && ny == oy) {
-            board_.setCell(ox, oy,
-                all_tanks_[k].player_index == 1 ? CellContent::TANK1 : CellContent::TANK2);
+            rules_.board.setCell(ox, oy,
+                rules_.tanks[k].player_index == 1 ? CellContent::TANK1 : CellContent::TANK2);
             continue;
         }
 
         // illegal: wall
-        if (board_.getCell(nx, ny).content == CellContent::WALL) {
+        if (rules_.board.getCell(nx, ny).content == CellContent::WALL) {
             ignored[k] = true;
-            board_.setCell(ox, oy,
-                all_tanks_[k].player_index == 1 ? CellContent::TANK1 : CellContent::TANK2);
+            rules_.board.setCell(ox, oy,
+                rules_.tanks[k].player_index == 1 ? CellContent::TANK1 : CellContent::TANK2);
             continue;
         }
 
-        // mutual shell‐tank destruction
-        {
-            bool collidedWithShell = false;
-            for (size_t s = 0; s < shells_.size(); ++s) {
-                if (shells_[s].x == nx && shells_[s].y == ny) {
-                    all_tanks_[k].alive = false;
-                    killedThisTurn[k]   = true;
-                    board_.setCell(ox, oy, CellContent::EMPTY);
-                    board_.setCell(nx, ny, CellContent::EMPTY);
-                    shells_.erase(shells_.begin() + s);
-                    collidedWithShell = true;
-                    break;
-                }
-            }
-            if (collidedWithShell) continue;
+        // mutual shell‐tank destruction (any shell still on the cell, lowest id first)
+        if (!shellsIndexed) {
+            shellPos_.resize(rules_.shells.size());
+            for (size_t s = 0; s < rules_.shells.size(); ++s) shellPos_[s] = { rules_.shells[s].x, rules_.shells[s].y };
+            indexShellsAt(shellPos_);
+            shellsIndexed = true;
+        }
+        if (int s = firstUnconsumedShellAt(nx, ny); s != -1) {
+            rules_.tanks[k].alive = false;
+            killedThisTurn[k]   = true;
+            rules_.board.setCell(ox, oy, CellContent::EMPTY);
+            rules_.board.setCell(nx, ny, CellContent::EMPTY);
+            rules_.shells[s].fate = ShellFate::Consumed;
+            continue;
         }
 
         // mine → both die
-        if (board_.getCell(nx, ny).content == CellContent::MINE) {
+        if (rules_.board.getCell(nx, ny).content == CellContent::MINE) {
             killedThisTurn[k]   = true;
-            all_tanks_[k].alive = false;
-            board_.setCell(ox, oy, CellContent::EMPTY);
-            board_.setCell(nx, ny, CellContent::EMPTY);
+            rules_.tanks[k].alive = false;
+            rules_.board.setCell(ox, oy, CellContent::EMPTY);
+            rules_.board.setCell(nx, ny, CellContent::EMPTY);
             continue;
         }
 
         // normal move
-        board_.setCell(ox, oy, CellContent::EMPTY);
-        all_tanks_[k].x = nx;
-        all_tanks_[k].y = ny;
-        board_.setCell(nx, ny,
-            all_tanks_[k].player_index == 1 ? CellContent::TANK1 : CellContent::TANK2);
+        rules_.board.setCell(ox, oy, CellContent::EMPTY);
+        rules_.tanks[k].x = nx;
+        rules_.tanks[k].y = ny;
+        rules_.board.setCell(nx, ny,
+            rules_.tanks[k].player_index == 1 ? CellContent::TANK1 : CellContent::TANK2);
     }
+    if (shellsIndexed) clearShellIndex();
 }
 
 void GameState::resolveShellCollisions() {
-    // if two or more shells occupy the same cell, they all die
-    for (auto const& entry : positionMap_) {
-        const auto& idxs = entry.second;
-        if (idxs.size() > 1) {
-            for (auto idx : idxs) toRemove_.insert(idx);
-        }
+    // if two or more half-step landings share a cell, every shell that landed there dies
+    for (auto const& [cell, idx] : visitLog_) {
+        if (cellVisits_[cell] > 1) rules_.shells[idx].fate = ShellFate::Destroyed;
     }
+    for (auto const& [cell, idx] : visitLog_) cellVisits_[cell] = 0;
+    visitLog_.clear();
 }
 
 void GameState::filterRemainingShells() {
-    std::vector<Shell> remaining;
-    remaining.reserve(shells_.size());
-    for (std::size_t i = 0; i < shells_.size(); ++i) {
-        if (toRemove_.count(i) == 0) {
-            auto& cell = board_.getCell(shells_[i].x, shells_[i].y);
-            cell.hasShellOverlay = true;
-            remaining.push_back(shells_[i]);
-        }
-    }
-    shells_.swap(remaining);
+    // compact in place, keeping survivor order
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < rules_.shells.size(); ++i) {
+        if (rules_.shells[i].fate != ShellFate::Live) continue;
+        rules_.board.markShell(rules_.shells[i].x, rules_.shells[i].y);
+        rules_.shells[out++] = rules_.shells[i];
+    }
+    rules_.shells.resize(out);
 }
 
 bool GameState::handleShellMidStepCollision(int x, int y) {
-    Cell& cell = board_.getCell(x, y);
+    const Cell& cell = rules_.board.getCell(x, y);
 
     // wall?
     if (cell.content == CellContent::WALL) {
-        cell.wallHits++;
-        if (cell.wallHits >= 2) cell.content = CellContent::EMPTY;
+        rules_.board.hitWall(x, y);
         return true;
     }
 
     // tank?
     if (cell.content == CellContent::TANK1 || cell.content == CellContent::TANK2) {
         int pid = (cell.content == CellContent::TANK1 ? 1 : 2);
-        for (auto& ts : all_tanks_) {
+        for (auto& ts : rules_.tanks) {
             if (ts.alive && ts.player_index == pid && ts.x == x && ts.y == y) {
                 ts.alive = false;
                 break;
             }
         }
-        cell.content = CellContent::EMPTY;
+        rules_.board.removeContent(x, y);
         return true;
     }
 
@@ -819,48 +862,126 @@ void GameState::cleanupDestroyedEntities() {
 
 void GameState::checkGameEndConditions() {
     int a1=0,a2=0;
-    for (auto const& ts: all_tanks_) {
+    for (auto const& ts: rules_.tanks) {
         if (ts.alive) (ts.player_index==1?++a1:++a2);
     }
 
     // Win / both-dead checks first (original precedence)
     if (a1==0 && a2==0) {
-        gameOver_=true; resultStr_="Tie, both players have zero tanks";
+        rules_.gameOver=true; rules_.result="Tie, both players have zero tanks";
         return;
     }
     if (a1==0) {
-        gameOver_=true; resultStr_="Player 2 won with "+std::to_string(a2)+" tanks still alive";
+        rules_.gameOver=true; rules_.result="Player 2 won with "+std::to_string(a2)+" tanks still alive";
         return;
     }
     if (a2==0) {
-        gameOver_=true; resultStr_="Player 1 won with "+std::to_string(a1)+" tanks still alive";
+        rules_.gameOver=true; rules_.result="Player 1 won with "+std::to_string(a1)+" tanks still alive";
         return;
     }
 
     // NEW: track consecutive turns where BOTH players have zero shells total
     std::size_t p1Shells=0, p2Shells=0;
-    for (auto const& ts: all_tanks_) {
+    for (auto const& ts: rules_.tanks) {
         if (!ts.alive) continue;
         if (ts.player_index==1) p1Shells += ts.shells_left;
         else                    p2Shells += ts.shells_left;
     }
-    if (p1Shells==0 && p2Shells==0) ++zeroShellsStreak_;
-    else                             zeroShellsStreak_ = 0;
+    if (p1Shells==0 && p2Shells==0) ++rules_.zeroShellsStreak;
+    else                             rules_.zeroShellsStreak = 0;
 
-    if (zeroShellsStreak_ >= ZERO_SHELLS_TIE_STREAK) {
-        gameOver_ = true;
+    if (rules_.zeroShellsStreak >= ZERO_SHELLS_TIE_STREAK) {
+        rules_.gameOver = true;
         // EXACT wording required
-        resultStr_ = "Tie, both players have zero shells for " +
+        rules_.result = "Tie, both players have zero shells for " +
                      std::to_string(ZERO_SHELLS_TIE_STREAK) + " steps";
         return;
     }
 
     // Max-steps tie (same wording you requested)
-    if (currentStep_ + 1 >= max_steps_) {
-        gameOver_ = true;
-        resultStr_ = "Tie, reached max steps = " + std::to_string(max_steps_) +
+    if (rules_.step + 1 >= max_steps_) {
+        rules_.gameOver = true;
+        rules_.result = "Tie, reached max steps = " + std::to_string(max_steps_) +
                      ", player 1 has " + std::to_string(a1) +
                      " tanks, player 2 has " + std::to_string(a2) + " tanks";
         return;
     }
 }
+
+// === time budgets (see Watchdog.h) ===
+namespace {
+std::string toMs(std::int64_t ns) { return std::to_string(ns / 1'000'000); }
+}
+
+void GameState::setLimits(std::uint64_t decisionMs, std::uint64_t gameMs) {
+    disarmLimits();
+    decisionBudgetNs_ = static_cast<std::int64_t>(decisionMs) * 1'000'000;
+    gameBudgetNs_     = static_cast<std::int64_t>(gameMs) * 1'000'000;
+    lastCallNs_ = 0;
+    algoNs_[0] = algoNs_[1] = 0;
+    limited_ = decisionMs > 0 || gameMs > 0;
+    if (!limited_) return;
+
+    watch_.decisionBudgetNs = decisionBudgetNs_;
+    watch_.decisionDeadline.store(0, std::memory_order_relaxed);
+    watch_.gameExpired.store(false, std::memory_order_relaxed);
+    watch_.gameDeadline.store(gameMs ? Watchdog::nowNs() + gameBudgetNs_ : 0, std::memory_order_relaxed);
+    const std::int64_t shortest = (decisionMs && gameMs) ? std::min(decisionBudgetNs_, gameBudgetNs_)
+                                                         : std::max(decisionBudgetNs_, gameBudgetNs_);
+    Watchdog::instance().requestTick(shortest / 10);
+    Watchdog::instance().watch(&watch_);
+}
+
+void GameState::disarmLimits() {
+    if (!limited_) return;
+    Watchdog::instance().unwatch(&watch_);
+    watch_.gameDeadline.store(0, std::memory_order_relaxed);
+    watch_.decisionDeadline.store(0, std::memory_order_relaxed);
+    limited_ = false;
+}
+
+GameState::BudgetedCall::BudgetedCall(GameState& g, int player)
+    : gs(g), side(player == 1 ? 0 : 1), start(Watchdog::nowNs()) {
+    if (gs.decisionBudgetNs_ > 0) {
+        gs.watch_.decisionDeadline.store(start + gs.decisionBudgetNs_, std::memory_order_relaxed);
+    }
+}
+
+GameState::BudgetedCall::~BudgetedCall() {
+    gs.watch_.decisionDeadline.store(0, std::memory_order_relaxed);
+    gs.lastCallNs_ = Watchdog::nowNs() - start;
+    gs.algoNs_[side] += gs.lastCallNs_;
+}
+
+// The tank whose algorithm overran its decision budget leaves the board
+void GameState::forfeitTank(std::size_t k) {
+    auto& ts = rules_.tanks[k];
+    ts.alive = false;
+    rules_.board.setCell(ts.x, ts.y, CellContent::EMPTY);
+    if (!timeoutNote_.empty()) timeoutNote_ += "; ";
+    timeoutNote_ += "player " + std::to_string(ts.player_index) + " tank " + std::to_string(ts.tank_index) +
+                    " forfeited after a " + toMs(lastCallNs_) + " ms algorithm call (budget " +
+                    toMs(decisionBudgetNs_) + " ms)";
+    WARN_PRINT("WATCHDOG", "gatherActionRequests", map_name_ + ": " + timeoutNote_);
+}
+
+// Out of game time: the player whose algorithms used more of it forfeits
+// all its tanks (both on an exact tie), which ends the game this turn
+void GameState::forfeitOnGameBudget() {
+    watch_.gameDeadline.store(0, std::memory_order_relaxed);
+    watch_.gameExpired.store(false, std::memory_order_relaxed);
+    const bool p1Out = algoNs_[0] >= algoNs_[1];
+    const bool p2Out = algoNs_[1] >= algoNs_[0];
+    for (auto& ts : rules_.tanks) {
+        if (!ts.alive || !(ts.player_index == 1 ? p1Out : p2Out)) continue;
+        ts.alive = false;
+        rules_.board.setCell(ts.x, ts.y, CellContent::EMPTY);
+    }
+    if (!timeoutNote_.empty()) timeoutNote_ += "; ";
+    timeoutNote_ += "game budget of " + toMs(gameBudgetNs_) + " ms exhausted at turn " +
+                    std::to_string(rules_.step + 1) + ", " +
+                    (p1Out && p2Out ? std::string("both players forfeit") :
+                                      "player " + std::to_string(p1Out ? 1 : 2) + " forfeits") +
+                    " (algorithm time p1 " + toMs(algoNs_[0]) + " ms, p2 " + toMs(algoNs_[1]) + " ms)";
+    WARN_PRINT("WATCHDOG", "advanceOneTurn", map_name_ + ": " + timeoutNote_);
+}
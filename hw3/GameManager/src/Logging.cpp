@@ -0,0 +1,73 @@
+// src/Logging.cpp
+#include "Logging.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace GameManager_315634022 {
+namespace logging {
+
+namespace {
+
+int parseLevel(const char* s, int fallback) {
+    if (!s || !*s) return fallback;
+    static const struct { const char* name; int level; } names[] = {
+        {"TRACE", GM_LOG_LEVEL_TRACE}, {"DEBUG", GM_LOG_LEVEL_DEBUG},
+        {"INFO",  GM_LOG_LEVEL_INFO},  {"WARN",  GM_LOG_LEVEL_WARN},
+        {"ERROR", GM_LOG_LEVEL_ERROR}, {"OFF",   GM_LOG_LEVEL_OFF},
+    };
+    for (const auto& n : names) {
+        if (std::strcmp(s, n.name) == 0) return n.level;
+    }
+    return fallback;
+}
+
+const char* levelName(int level) {
+    switch (level) {
+        case GM_LOG_LEVEL_TRACE: return "TRACE";
+        case GM_LOG_LEVEL_DEBUG: return "DEBUG";
+        case GM_LOG_LEVEL_INFO:  return "INFO";
+        case GM_LOG_LEVEL_WARN:  return "WARN";
+        default:                 return "ERROR";
+    }
+}
+
+std::mutex g_log_mutex;
+std::atomic<int> g_runtime_level{parseLevel(std::getenv("GM_LOG_LEVEL"), GM_LOG_LEVEL_INFO)};
+
+} // namespace
+
+int runtimeLevel() {
+    return g_runtime_level.load(std::memory_order_relaxed);
+}
+
+void setRuntimeLevel(int level) {
+    g_runtime_level.store(level, std::memory_order_relaxed);
+}
+
+void write(int level, const char* component, const char* function, const std::string& message) {
+    // Format outside the lock; hold it only for the single stream write.
+    std::ostringstream line;
+    line << "[T" << std::this_thread::get_id() << "] [" << levelName(level) << "] ["
+         << component << "] [" << function << "] " << message << '\n';
+    const std::string out = line.str();
+
+    std::lock_guard<std::mutex> lock(g_log_mutex);
+    if (level >= GM_LOG_LEVEL_WARN) {
+        std::cerr << out << std::flush;
+    } else {
+        std::cout << out << std::flush;
+    }
+}
+
+void writeBlock(const std::string& block) {
+    std::lock_guard<std::mutex> lock(g_log_mutex);
+    std::cout << block << std::flush;
+}
+
+} // namespace logging
+} // namespace GameManager_315634022
@@ -0,0 +1,283 @@
+// Replay.cpp
+#include "Replay.h"
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+
+namespace GameManager_315634022 {
+namespace replay {
+
+static_assert(std::endian::native == std::endian::little, "replay records are written in host byte order");
+static_assert(sizeof(RecordHeader) == 48, "RecordHeader is written raw");
+
+namespace {
+
+constexpr std::size_t kStringCount = 5;           // log name, map, player 1, player 2, final line
+constexpr std::uint32_t kMaxString = 1u << 20;    // sanity bound when reading
+
+std::atomic<int> g_containerFd{-1};
+
+void putString(std::string& out, const std::string& s) {
+    const std::uint32_t n = static_cast<std::uint32_t>(s.size());
+    out.append(reinterpret_cast<const char*>(&n), sizeof(n));
+    out += s;
+}
+
+bool getString(std::istream& in, std::string& s) {
+    std::uint32_t n = 0;
+    if (!in.read(reinterpret_cast<char*>(&n), sizeof(n)) || n > kMaxString) return false;
+    s.resize(n);
+    return static_cast<bool>(in.read(s.data(), n));
+}
+
+bool writeAll(int fd, const std::string& data) {
+    const char* p = data.data();
+    std::size_t left = data.size();
+    while (left > 0) {
+        const ssize_t n = ::write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool validHeader(const RecordHeader& h) {
+    return std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0 && h.version == kVersion &&
+           h.recordSize >= sizeof(RecordHeader);
+}
+
+std::uint64_t streamBytes(std::uint64_t codes) {
+    return (codes * kCodeBits + 7) / 8;
+}
+
+// Reads the record's string lengths (and its log name) and checks that they,
+// the board and the turn stream add up to exactly recordSize, before
+// anything is sized from the header
+bool consistentRecord(std::istream& in, const RecordHeader& h, std::string& logName) {
+    std::uint64_t left = h.recordSize - sizeof(RecordHeader);
+    for (std::size_t k = 0; k < kStringCount; ++k) {
+        std::uint32_t n = 0;
+        if (!in.read(reinterpret_cast<char*>(&n), sizeof(n)) || n > kMaxString || sizeof(n) + std::uint64_t(n) > left) {
+            return false;
+        }
+        left -= sizeof(n) + n;
+        if (k == 0) {
+            logName.resize(n);
+            if (!in.read(logName.data(), n)) return false;
+        } else {
+            in.seekg(n, std::ios::cur);
+        }
+    }
+    const std::uint64_t cells = std::uint64_t(h.rows) * h.cols;   // u32*u32 cannot overflow
+    if (cells > left) return false;
+    left -= cells;
+    const std::uint64_t codes = std::uint64_t(h.turns) * h.tanks;
+    if (codes > left * 8 / kCodeBits) return false;               // keeps streamBytes() from overflowing
+    return streamBytes(codes) == left;
+}
+
+} // namespace
+
+// ---------- text rendering (shared with GameState's turn log) ----------
+
+const char* actionName(ActionRequest a) {
+    switch (a) {
+        case ActionRequest::MoveForward:    return "MoveForward";
+        case ActionRequest::MoveBackward:   return "MoveBackward";
+        case ActionRequest::RotateLeft90:   return "RotateLeft90";
+        case ActionRequest::RotateRight90:  return "RotateRight90";
+        case ActionRequest::RotateLeft45:   return "RotateLeft45";
+        case ActionRequest::RotateRight45:  return "RotateRight45";
+        case ActionRequest::Shoot:          return "Shoot";
+        case ActionRequest::GetBattleInfo:  return "GetBattleInfo";
+        case ActionRequest::DoNothing:      return "DoNothing";
+    }
+    return "Unknown";
+}
+
+void appendTankEntry(std::string& out, std::uint8_t code) {
+    const ActionRequest act = codeAction(code);
+    switch (codeMark(code)) {
+        case Plain:
+            out += actionName(act);
+            break;
+        case Ignored:
+            out += actionName(act);
+            out += " (ignored)";
+            break;
+        case Killed:
+            if (act == ActionRequest::DoNothing) {
+                out += "killed";
+            } else {
+                out += actionName(act);
+                out += " (killed)";
+            }
+            break;
+    }
+}
+
+std::string turnLine(const std::uint8_t* codes, std::size_t tanks) {
+    std::string out;
+    for (std::size_t k = 0; k < tanks; ++k) {
+        appendTankEntry(out, codes[k]);
+        if (k + 1 < tanks) out += ", ";
+    }
+    return out;
+}
+
+std::string Game::textLog() const {
+    std::string out;
+    for (std::size_t t = 0; t < header.turns; ++t) {
+        out += turnLine(turn(t), header.tanks);
+        out += '\n';
+    }
+    if (!finalLine.empty()) {
+        out += finalLine;
+        out += '\n';
+    }
+    return out;
+}
+
+std::uint64_t hashBoard(const SatelliteView& view, std::size_t rows, std::size_t cols) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (std::size_t y = 0; y < rows; ++y) {
+        for (std::size_t x = 0; x < cols; ++x) {
+            h ^= static_cast<unsigned char>(view.getObjectAt(x, y));
+            h *= 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+// ---------- writing ----------
+
+void Writer::begin(const std::string& logName, const std::string& mapName,
+                   const std::string& name1, const std::string& name2,
+                   const SatelliteView& map, std::size_t rows, std::size_t cols,
+                   std::size_t maxSteps, std::size_t numShells, std::size_t tanks) {
+    header_ = RecordHeader{};
+    std::memcpy(header_.magic, kMagic, sizeof(kMagic));
+    header_.version   = kVersion;
+    header_.mapHash   = hashBoard(map, rows, cols);
+    header_.rows      = static_cast<std::uint32_t>(rows);
+    header_.cols      = static_cast<std::uint32_t>(cols);
+    header_.maxSteps  = static_cast<std::uint32_t>(maxSteps);
+    header_.numShells = static_cast<std::uint32_t>(numShells);
+    header_.tanks     = static_cast<std::uint32_t>(tanks);
+    strings_[0] = logName;
+    strings_[1] = mapName;
+    strings_[2] = name1;
+    strings_[3] = name2;
+
+    board_.resize(rows * cols);
+    for (std::size_t y = 0; y < rows; ++y) {
+        for (std::size_t x = 0; x < cols; ++x) board_[y * cols + x] = map.getObjectAt(x, y);
+    }
+    bits_.clear();
+    bitCount_ = 0;
+}
+
+void Writer::addTurn(const std::vector<std::uint8_t>& codes) {
+    for (std::uint8_t code : codes) {
+        const std::uint64_t byte = bitCount_ / 8;
+        const unsigned shift = static_cast<unsigned>(bitCount_ % 8);
+        if (bits_.size() < byte + 2) bits_.resize(byte + 2, '\0');
+        const unsigned v = static_cast<unsigned>(code) << shift;   // at most 12 bits
+        bits_[byte]     = static_cast<char>(static_cast<unsigned char>(bits_[byte]) | (v & 0xFF));
+        bits_[byte + 1] = static_cast<char>(static_cast<unsigned char>(bits_[byte + 1]) | (v >> 8));
+        bitCount_ += kCodeBits;
+    }
+    ++header_.turns;
+}
+
+bool Writer::finish(const std::string& finalLine, int fd) {
+    record_.clear();
+    record_.append(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    for (const auto& s : strings_) putString(record_, s);
+    putString(record_, finalLine);
+    record_ += board_;
+    record_.append(bits_.data(), streamBytes(std::uint64_t(header_.turns) * header_.tanks));
+
+    const std::uint64_t size = record_.size();
+    std::memcpy(record_.data() + offsetof(RecordHeader, recordSize), &size, sizeof(size));
+    return fd >= 0 && writeAll(fd, record_);
+}
+
+bool openContainer(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    const int old = g_containerFd.exchange(fd);
+    if (old >= 0) ::close(old);
+    return true;
+}
+
+int containerFd() {
+    return g_containerFd.load(std::memory_order_relaxed);
+}
+
+// ---------- reading ----------
+
+bool Reader::open(const std::string& path) {
+    path_ = path;
+    entries_.clear();
+    truncated_ = false;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(in.tellg());
+
+    std::uint64_t offset = 0;
+    while (offset < fileSize) {
+        Entry e;
+        e.offset = offset;
+        in.seekg(static_cast<std::streamoff>(offset));
+        if (!in.read(reinterpret_cast<char*>(&e.header), sizeof(e.header)) || !validHeader(e.header) ||
+            e.header.recordSize > fileSize - offset || !consistentRecord(in, e.header, e.logName)) {
+            truncated_ = true;   // a torn append or a corrupt header; everything before it is intact
+            break;
+        }
+        offset += e.header.recordSize;
+        entries_.push_back(std::move(e));
+    }
+    return true;
+}
+
+bool Reader::load(std::size_t index, Game& out) const {
+    if (index >= entries_.size()) return false;
+    const Entry& e = entries_[index];
+    std::ifstream in(path_, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(e.offset + sizeof(RecordHeader)));
+    out.header = e.header;
+    std::string* strings[kStringCount] = {&out.logName, &out.mapName, &out.name1, &out.name2, &out.finalLine};
+    for (std::string* s : strings) {
+        if (!getString(in, *s)) return false;
+    }
+    const RecordHeader& h = e.header;
+    out.board.resize(std::size_t(h.rows) * h.cols);
+    if (!in.read(out.board.data(), static_cast<std::streamsize>(out.board.size()))) return false;
+
+    const std::uint64_t codeCount = std::uint64_t(h.turns) * h.tanks;
+    std::string bits(streamBytes(codeCount), '\0');
+    if (!in.read(bits.data(), static_cast<std::streamsize>(bits.size()))) return false;
+    bits.push_back('\0');   // decoding reads one byte past the last code
+    out.codes.resize(codeCount);
+    for (std::uint64_t c = 0; c < codeCount; ++c) {
+        const std::uint64_t bit = c * kCodeBits;
+        const unsigned v = static_cast<unsigned char>(bits[bit / 8]) |
+                           (static_cast<unsigned>(static_cast<unsigned char>(bits[bit / 8 + 1])) << 8);
+        out.codes[c] = static_cast<std::uint8_t>((v >> (bit % 8)) & ((1u << kCodeBits) - 1));
+    }
+    return true;
+}
+
+} // namespace replay
+} // namespace GameManager_315634022
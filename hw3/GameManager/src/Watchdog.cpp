@@ -0,0 +1,82 @@
+// src/Watchdog.cpp
+#include "Watchdog.h"
+#include "Logging.h"
+
+#include <GameLimits.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace GameManager_315634022 {
+
+Watchdog& Watchdog::instance() {
+    static Watchdog w;
+    return w;
+}
+
+std::int64_t Watchdog::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Joined when the GameManager library is unloaded, before its code goes away
+Watchdog::~Watchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void Watchdog::watch(GameWatch* w) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    games_.push_back(w);
+    if (!thread_.joinable()) thread_ = std::thread([this] { run(); });
+}
+
+void Watchdog::unwatch(GameWatch* w) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    games_.erase(std::remove(games_.begin(), games_.end(), w), games_.end());
+}
+
+void Watchdog::requestTick(std::int64_t ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tickNs_ = std::clamp(std::min(tickNs_, ns), kMinTickNs, kMaxTickNs);
+}
+
+void Watchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        cond_.wait_for(lock, std::chrono::nanoseconds(tickNs_));
+        const std::int64_t now = nowNs();
+        for (GameWatch* w : games_) check(*w, now);
+    }
+}
+
+void Watchdog::check(GameWatch& w, std::int64_t now) {
+    const std::int64_t game = w.gameDeadline.load(std::memory_order_relaxed);
+    if (game != 0 && now > game) w.gameExpired.store(true, std::memory_order_relaxed);
+
+    const std::int64_t decision = w.decisionDeadline.load(std::memory_order_relaxed);
+    if (decision == 0 || now <= decision) return;
+
+    // An overrun itself is judged by the game once the call returns; only
+    // a call that never does needs reporting from here
+    const std::int64_t hangAfter = std::max(kHangFactor * w.decisionBudgetNs, kMinHangNs);
+    if (now <= decision + hangAfter || w.hangReported == decision) return;
+    w.hangReported = decision;
+    const std::string late = "Algorithm call has not returned " + std::to_string((now - decision) / 1'000'000) +
+                             " ms past its deadline";
+    if (exitOnHang_.load(std::memory_order_relaxed)) {
+        // A worker process: nothing else runs here, so end it and let the pool replace it
+        ERROR_PRINT("WATCHDOG", "check", late + "; ending the worker process");
+        std::fflush(nullptr);
+        ::_exit(UserCommon_315634022::kHangExitStatus);
+    }
+    ERROR_PRINT("WATCHDOG", "check", late + "; its thread cannot be reclaimed in-process (use isolation=process)");
+}
+
+} // namespace GameManager_315634022
@@ -0,0 +1,230 @@
+// tools/ReplayTool.cpp
+//
+// Reads a replay container written with replay_file=<file> (see Replay.h).
+// Built by `make replay`.
+//
+// Usage: replay_tool list <file>
+//        replay_tool text <file> [out_dir]
+//        replay_tool show <file> <game> <turn> [every=K]
+//        replay_tool play <file> <game> [speed=<turns/s>] [from=N] [to=N] [every=K]
+//   list  one line per game: index, map, players, size, turns, final line
+//   text  write every game back out as the log_*.txt file it replaced
+//   show  print the board after <turn> turns, re-simulated with GameState
+//   play  animate turns in the terminal; speed may be fractional, 0 = as fast
+//         as possible (default 10). Only changed cells are redrawn.
+// show and play keep a GameState snapshot every K turns (default 64), so a
+// seek replays fewer than K turns.
+
+#include "Replay.h"
+#include "ReplayViewer.h"
+#include <GameManagerRegistration.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// GameManager_315634022.cpp registers itself with the simulator; the tool
+// links it but never uses the registration.
+GameManagerRegistration::GameManagerRegistration(GameManagerFactory) {}
+
+using namespace GameManager_315634022;
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kDefaultSnapshotEvery = 64;
+
+int usage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s list <file>\n"
+                 "       %s text <file> [out_dir]\n"
+                 "       %s show <file> <game> <turn> [every=K]\n"
+                 "       %s play <file> <game> [speed=<turns/s>] [from=N] [to=N] [every=K]\n",
+                 prog, prog, prog, prog);
+    return 2;
+}
+
+// Optional key=value arguments of show/play
+struct ViewOptions {
+    std::size_t every = kDefaultSnapshotEvery;
+    double      speed = 10.0;
+    std::size_t from  = 0;
+    std::size_t to    = ReplayViewer::npos;
+};
+
+bool parseViewOption(const std::string& arg, ViewOptions& opt) {
+    const auto eq = arg.find('=');
+    if (eq == std::string::npos) return false;
+    const std::string key = arg.substr(0, eq);
+    const char* value = arg.c_str() + eq + 1;
+    char* end = nullptr;
+    if (key == "speed") {
+        opt.speed = std::strtod(value, &end);
+        return *value && !*end && opt.speed >= 0;
+    }
+    const unsigned long long n = std::strtoull(value, &end, 10);
+    if (!*value || *end) return false;
+    if (key == "every" && n > 0) { opt.every = n; return true; }
+    if (key == "from")           { opt.from = n; return true; }
+    if (key == "to")             { opt.to = n; return true; }
+    return false;
+}
+
+bool parseIndex(const char* text, std::size_t& out) {
+    char* end = nullptr;
+    out = std::strtoull(text, &end, 10);
+    return *text && !*end;
+}
+
+bool openContainer(const std::string& path, replay::Reader& reader) {
+    if (!reader.open(path)) {
+        std::fprintf(stderr, "Cannot open replay file '%s'\n", path.c_str());
+        return false;
+    }
+    if (reader.truncated()) {
+        std::fprintf(stderr, "warning: '%s' ends in a partial or corrupt record; it and anything after it were skipped\n", path.c_str());
+    }
+    return true;
+}
+
+int listGames(const replay::Reader& reader) {
+    for (std::size_t i = 0; i < reader.entries().size(); ++i) {
+        replay::Game game;
+        if (!reader.load(i, game)) {
+            std::fprintf(stderr, "Cannot decode record %zu\n", i);
+            return 1;
+        }
+        const auto& h = game.header;
+        std::printf("%zu\t%s\t%s vs %s\t%ux%u\t%u tanks\t%u turns\t%s\n", i, game.mapName.c_str(),
+                    game.name1.c_str(), game.name2.c_str(), h.cols, h.rows, h.tanks, h.turns,
+                    game.finalLine.c_str());
+    }
+    return 0;
+}
+
+int writeTextLogs(const replay::Reader& reader, const fs::path& outDir) {
+    std::error_code ec;
+    fs::create_directories(outDir, ec);
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < reader.entries().size(); ++i) {
+        replay::Game game;
+        if (!reader.load(i, game)) {
+            std::fprintf(stderr, "Cannot decode record %zu\n", i);
+            return 1;
+        }
+        // The name comes from the file: keep only its last component so it stays in outDir
+        const fs::path name = fs::path(game.logName).filename();
+        if (name.empty() || name == "." || name == "..") {
+            std::fprintf(stderr, "warning: record %zu has no usable log name ('%s'); skipped\n", i, game.logName.c_str());
+            continue;
+        }
+        const fs::path path = outDir / name;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const std::string text = game.textLog();
+        if (!out.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+            std::fprintf(stderr, "Cannot write '%s'\n", path.c_str());
+            return 1;
+        }
+        ++written;
+    }
+    std::printf("Wrote %zu logs to %s\n", written, outDir.c_str());
+    return 0;
+}
+
+bool loadGame(const replay::Reader& reader, const char* indexText, replay::Game& game) {
+    std::size_t index = 0;
+    if (!parseIndex(indexText, index) || index >= reader.entries().size()) {
+        std::fprintf(stderr, "No game %s (the file has %zu)\n", indexText, reader.entries().size());
+        return false;
+    }
+    if (!reader.load(index, game)) {
+        std::fprintf(stderr, "Cannot decode record %zu\n", index);
+        return false;
+    }
+    return true;
+}
+
+void reportDivergence(const ReplayViewer& viewer) {
+    if (viewer.divergedAt() != ReplayViewer::npos) {
+        std::fprintf(stderr, "warning: the re-simulation differs from the record from turn %zu on "
+                             "(e.g. a time-budget forfeit)\n", viewer.divergedAt());
+    }
+}
+
+std::string statusLine(const ReplayViewer& viewer) {
+    return "turn " + std::to_string(viewer.turn()) + "/" + std::to_string(viewer.turns()) + "  " +
+           viewer.lastTurnLine();
+}
+
+int showTurn(const replay::Game& game, std::size_t turn, const ViewOptions& opt) {
+    ReplayViewer viewer(game, opt.every);
+    reportDivergence(viewer);
+    const auto start = Clock::now();
+    viewer.seek(turn);
+    const double seekUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    std::vector<std::uint8_t> frame;
+    viewer.frame(frame);
+    TerminalRenderer renderer;
+    renderer.draw(frame, game.header.rows, game.header.cols, statusLine(viewer));
+    renderer.finish();
+    std::printf("seek %.1f us, %zu snapshots every %zu turns\n", seekUs, viewer.snapshotCount(), opt.every);
+    return 0;
+}
+
+int playGame(const replay::Game& game, const ViewOptions& opt) {
+    ReplayViewer viewer(game, opt.every);
+    reportDivergence(viewer);
+    const auto period = opt.speed > 0 ? std::chrono::duration<double>(1.0 / opt.speed) : std::chrono::duration<double>(0);
+    std::vector<std::uint8_t> frame;
+    TerminalRenderer renderer;
+
+    viewer.seek(opt.from);
+    auto next = Clock::now();
+    for (;;) {
+        viewer.frame(frame);
+        renderer.draw(frame, game.header.rows, game.header.cols, statusLine(viewer));
+        if (viewer.turn() >= opt.to || !viewer.step()) break;
+        next += std::chrono::duration_cast<Clock::duration>(period);
+        std::this_thread::sleep_until(next);
+    }
+    renderer.finish();
+    if (!game.finalLine.empty()) std::printf("%s\n", game.finalLine.c_str());
+    return 0;
+}
+
+int viewCommand(const std::string& cmd, int argc, char** argv) {
+    const int first = cmd == "show" ? 5 : 4;   // first key=value argument
+    std::size_t turn = 0;
+    if (argc < first || (cmd == "show" && !parseIndex(argv[4], turn))) return usage(argv[0]);
+    ViewOptions opt;
+    for (int i = first; i < argc; ++i) {
+        if (!parseViewOption(argv[i], opt)) return usage(argv[0]);
+    }
+    replay::Reader reader;
+    replay::Game game;
+    if (!openContainer(argv[2], reader) || !loadGame(reader, argv[3], game)) return 1;
+    return cmd == "show" ? showTurn(game, turn, opt) : playGame(game, opt);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage(argv[0]);
+    const std::string cmd = argv[1];
+    replay::Reader reader;
+    if (cmd == "list" && argc == 3) {
+        return openContainer(argv[2], reader) ? listGames(reader) : 1;
+    }
+    if (cmd == "text" && argc <= 4) {
+        return openContainer(argv[2], reader) ? writeTextLogs(reader, argc == 4 ? argv[3] : ".") : 1;
+    }
+    if (cmd == "show" || cmd == "play") return viewCommand(cmd, argc, argv);
+    return usage(argv[0]);
+}
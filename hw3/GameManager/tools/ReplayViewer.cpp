@@ -0,0 +1,159 @@
+// tools/ReplayViewer.cpp
+#include "ReplayViewer.h"
+
+#include <SatelliteView.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace GameManager_315634022 {
+
+namespace {
+
+// Recorded initial board as the SatelliteView GameState::reset() loads
+class RecordedBoardView : public SatelliteView {
+public:
+    RecordedBoardView(const std::string& cells, std::size_t rows, std::size_t cols)
+        : cells_(cells), rows_(rows), cols_(cols) {}
+    char getObjectAt(size_t x, size_t y) const override {
+        return (x < cols_ && y < rows_) ? cells_[y * cols_ + x] : '&';
+    }
+private:
+    const std::string& cells_;
+    std::size_t rows_, cols_;
+};
+
+} // namespace
+
+// ---------- re-simulation ----------
+
+ReplayViewer::ReplayViewer(const replay::Game& game, std::size_t snapshotEvery)
+    : game_(game), every_(snapshotEvery == 0 ? 1 : snapshotEvery) {
+    // GameState numbers tanks in row-major board order, per player and overall
+    tankOf_.resize(3);
+    std::size_t slot = 0;
+    for (char c : game_.board) {
+        if (c == '1' || c == '2') tankOf_[c - '0'].push_back(slot++);
+    }
+    buildSnapshots();
+}
+
+ActionRequest ReplayViewer::recordedAction(std::size_t tank) const {
+    const std::size_t t = state_.getCurrentTurn();
+    if (t >= turns() || tank >= game_.header.tanks) return ActionRequest::DoNothing;
+    return replay::codeAction(game_.turn(t)[tank]);
+}
+
+void ReplayViewer::restart() {
+    const auto& h = game_.header;
+    RecordedBoardView view(game_.board, h.rows, h.cols);
+    auto factory = [this](int player, int tank) {
+        return std::make_unique<RecordedTank>(*this, tankOf_[player].at(std::size_t(tank)));
+    };
+    state_.reset(view, h.cols, h.rows, game_.mapName, h.maxSteps, h.numShells,
+                 player1_, game_.name1, player2_, game_.name2, factory, factory, false);
+    state_.setTurnCodesOnly(true);
+}
+
+// One full pass: snapshot every K turns and check each turn against the record
+void ReplayViewer::buildSnapshots() {
+    restart();
+    snapshots_.clear();
+    for (;;) {
+        const std::size_t t = state_.getCurrentTurn();
+        if (t % every_ == 0) state_.cloneRules(snapshots_.emplace_back());
+        if (t >= turns() || state_.isGameOver()) break;
+        state_.advanceOneTurn();
+        const auto& codes = state_.getTurnCodes();
+        if (divergedAt_ == npos &&
+            (codes.size() != game_.header.tanks || std::memcmp(codes.data(), game_.turn(t), codes.size()) != 0)) {
+            divergedAt_ = t + 1;
+        }
+    }
+    if (divergedAt_ == npos && state_.getCurrentTurn() != turns()) divergedAt_ = state_.getCurrentTurn() + 1;
+    seek(0);
+}
+
+void ReplayViewer::seek(std::size_t turn) {
+    const std::size_t i = std::min(turn / every_, snapshots_.size() - 1);
+    state_.restoreRules(snapshots_[i]);
+    while (state_.getCurrentTurn() < turn && step()) {}
+}
+
+bool ReplayViewer::step() {
+    if (state_.getCurrentTurn() >= turns() || state_.isGameOver()) return false;
+    state_.advanceOneTurn();
+    return true;
+}
+
+std::string ReplayViewer::lastTurnLine() const {
+    const std::size_t t = turn();
+    return t == 0 ? std::string() : replay::turnLine(game_.turn(t - 1), game_.header.tanks);
+}
+
+void ReplayViewer::frame(std::vector<std::uint8_t>& out) const {
+    const Board& board = state_.getBoard();
+    out.resize(board.getCells().size());
+    for (int y = 0; y < board.getHeight(); ++y) {
+        for (int x = 0; x < board.getWidth(); ++x) {
+            const Cell& cell = board.getCell(x, y);
+            std::uint8_t glyph = ' ';
+            if (cell.hasShellOverlay) {
+                glyph = '*';
+            } else if (cell.content == CellContent::TANK1 || cell.content == CellContent::TANK2) {
+                const int dir = state_.tankDirectionAt(x, y);
+                glyph = std::uint8_t((cell.content == CellContent::TANK1 ? kTank1 : kTank2) + (dir < 0 ? 0 : dir));
+            } else {
+                glyph = std::uint8_t(contentToChar(cell.content));
+            }
+            out[board.index(x, y)] = glyph;
+        }
+    }
+}
+
+// ---------- terminal output ----------
+
+void TerminalRenderer::appendGlyph(std::string& out, std::uint8_t cell) {
+    if (cell >= ReplayViewer::kTank1 && cell < ReplayViewer::kTank2 + 8) {
+        out += cell < ReplayViewer::kTank2 ? "\033[31m" : "\033[34m";
+        out += GameState::directionToArrow(cell & 7);
+        out += "\033[0m";
+    } else {
+        out += char(cell);
+    }
+}
+
+void TerminalRenderer::draw(const std::vector<std::uint8_t>& frame, std::size_t rows, std::size_t cols,
+                            const std::string& status) {
+    char pos[64];
+    out_.clear();
+    if (rows != rows_ || cols != cols_ || shown_.size() != frame.size()) {
+        out_ += "\033[2J\033[H";
+        for (std::size_t y = 0; y < rows; ++y) {
+            for (std::size_t x = 0; x < cols; ++x) appendGlyph(out_, frame[y * cols + x]);
+            out_ += '\n';
+        }
+        rows_ = rows;
+        cols_ = cols;
+    } else {
+        for (std::size_t i = 0; i < frame.size(); ++i) {
+            if (frame[i] == shown_[i]) continue;
+            std::snprintf(pos, sizeof(pos), "\033[%zu;%zuH", i / cols + 1, i % cols + 1);
+            out_ += pos;
+            appendGlyph(out_, frame[i]);
+        }
+    }
+    shown_ = frame;
+    std::snprintf(pos, sizeof(pos), "\033[%zu;1H\033[2K", rows + 1);
+    out_ += pos;
+    out_ += status;
+    std::fwrite(out_.data(), 1, out_.size(), stdout);
+    std::fflush(stdout);
+}
+
+void TerminalRenderer::finish() {
+    std::printf("\033[%zu;1H\n", rows_ + 2);
+    std::fflush(stdout);
+}
+
+} // namespace GameManager_315634022
@@ -0,0 +1,91 @@
+// tools/ReplayViewer.h
+#pragma once
+
+#include "GameState.h"
+#include "Replay.h"
+
+#include <Player.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GameManager_315634022 {
+
+/// Re-simulates one recorded game with the real GameState rules: every tank
+/// gets an algorithm that replays its recorded actions. The first pass
+/// checks each turn against the record and keeps a snapshot every K turns,
+/// so seek(n) restores the nearest earlier snapshot and replays < K turns.
+class ReplayViewer {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    ReplayViewer(const replay::Game& game, std::size_t snapshotEvery);
+    ReplayViewer(const ReplayViewer&) = delete;              // the tanks point back here
+    ReplayViewer& operator=(const ReplayViewer&) = delete;
+
+    std::size_t turns() const { return game_.header.turns; }
+    std::size_t turn() const { return state_.getCurrentTurn(); }
+    /// First turn whose re-simulated log differs from the record (e.g. a
+    /// time-budget forfeit, which the record cannot reproduce); npos if none.
+    std::size_t divergedAt() const { return divergedAt_; }
+    std::size_t snapshotCount() const { return snapshots_.size(); }
+
+    void seek(std::size_t turn);
+    /// One turn forward; false at the end of the record.
+    bool step();
+
+    /// One byte per cell, row-major: ' ', '#', '@', '*', or a tank as
+    /// kTank1/kTank2 plus its direction.
+    static constexpr std::uint8_t kTank1 = 0x10, kTank2 = 0x18;
+    void frame(std::vector<std::uint8_t>& out) const;
+    /// Text-log line of the last turn played ("" before turn 1).
+    std::string lastTurnLine() const;
+
+private:
+    // Feeds each tank its recorded action for the current turn
+    class RecordedTank : public TankAlgorithm {
+    public:
+        RecordedTank(const ReplayViewer& viewer, std::size_t tank) : viewer_(viewer), tank_(tank) {}
+        ActionRequest getAction() override { return viewer_.recordedAction(tank_); }
+        void updateBattleInfo(BattleInfo&) override {}
+    private:
+        const ReplayViewer& viewer_;
+        std::size_t         tank_;
+    };
+    class SilentPlayer : public Player {
+    public:
+        void updateTankWithBattleInfo(TankAlgorithm&, SatelliteView&) override {}
+    };
+
+    ActionRequest recordedAction(std::size_t tank) const;
+    void restart();
+    void buildSnapshots();
+
+    replay::Game game_;
+    std::size_t  every_;
+    std::size_t  divergedAt_ = npos;
+    std::vector<std::vector<std::size_t>> tankOf_;   // [player][tank index] -> recorded tank slot
+    SilentPlayer player1_, player2_;
+    GameState    state_;
+    std::vector<RulesState> snapshots_;              // snapshots_[i] is turn i * every_
+};
+
+/// Draws frames on an ANSI terminal, rewriting only the cells that changed
+/// since the previous frame.
+class TerminalRenderer {
+public:
+    void draw(const std::vector<std::uint8_t>& frame, std::size_t rows, std::size_t cols,
+              const std::string& status);
+    /// Park the cursor below the board.
+    void finish();
+
+private:
+    static void appendGlyph(std::string& out, std::uint8_t cell);
+
+    std::vector<std::uint8_t> shown_;
+    std::size_t rows_ = 0, cols_ = 0;
+    std::string out_;
+};
+
+} // namespace GameManager_315634022
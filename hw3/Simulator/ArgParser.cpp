@@ -14,13 +14,20 @@ void printUsage(const char* prog) {
               << "      game_managers_folder=<dir> \\\n"
               << "      algorithm1=<so> \\\n"
               << "      algorithm2=<so> \\\n"
-              << "      [num_threads=<N>] [-verbose]\n\n"
+              << "      [num_threads=<N>] [map_cache=<dir>] [-verbose] \\\n"
+              << "      [decision_timeout_ms=<N>] [game_timeout_ms=<N>] [replay_file=<file>]\n\n"
               << "  Competition mode:\n"
               << "    " << prog << " -competition \\\n"
               << "      game_maps_folder=<dir> \\\n"
               << "      game_manager=<so> \\\n"
               << "      algorithms_folder=<dir> \\\n"
-              << "      [num_threads=<N>] [-verbose]\n";
+              << "      [num_threads=<N>] [map_cache=<dir>] [-verbose] [-profile] [-keep_final_boards] \\\n"
+              << "      [scheduler=fifo|cost] [schedule_history=<file>] [journal=<file>] [resume=<file>] \\\n"
+              << "      [shard=<i>/<n>] [isolation=thread|process] [result_cache=<dir>] \\\n"
+              << "      [metrics_file=<file>] [metrics_interval_ms=<N>] \\\n"
+              << "      [decision_timeout_ms=<N>] [game_timeout_ms=<N>] [replay_file=<file>]\n\n"
+              << "  Merge mode (combine the shard_<i>of<n>.txt files of a sharded competition):\n"
+              << "    " << prog << " -merge algorithms_folder=<dir>\n";
 }
 
 bool parseArguments(int argc, char* argv[], Config& cfg) {
@@ -46,8 +53,11 @@ void parseArgumentsList(int argc, char* argv[], Config& cfg, std::vector<std::st
 bool processArgument(const std::string& arg, Config& cfg) {
     if      (arg == "-comparative")            { cfg.modeComparative = true; return true; }
     else if (arg == "-competition")            { cfg.modeCompetition = true; return true; }
+    else if (arg == "-merge")                  { cfg.modeMerge = true; return true; }
     else if (arg == "-verbose")                { cfg.verbose = true; return true; }
     else if (arg == "--debug")                  { cfg.debug = true; return true; }
+    else if (arg == "-profile")                { cfg.profile = true; return true; }
+    else if (arg == "-keep_final_boards")      { cfg.keepFinalBoards = true; return true; }
     else if (arg.rfind("num_threads=", 0) == 0) { cfg.numThreads = std::stoi(stripKey(arg, "num_threads=")); return true; }
     else if (arg.rfind("game_map=", 0) == 0)    { cfg.game_map = stripKey(arg, "game_map="); return true; }
     else if (arg.rfind("game_managers_folder=",0)==0) { cfg.game_managers_folder = stripKey(arg, "game_managers_folder="); return true; }
@@ -56,10 +66,50 @@ bool processArgument(const std::string& arg, Config& cfg) {
     else if (arg.rfind("game_maps_folder=",0)==0) { cfg.game_maps_folder = stripKey(arg, "game_maps_folder="); return true; }
     else if (arg.rfind("game_manager=",0) == 0) { cfg.game_manager = stripKey(arg, "game_manager="); return true; }
     else if (arg.rfind("algorithms_folder=",0)==0) { cfg.algorithms_folder = stripKey(arg, "algorithms_folder="); return true; }
+    else if (arg.rfind("map_cache=",0) == 0)    { cfg.map_cache = stripKey(arg, "map_cache="); return true; }
+    else if (arg.rfind("schedule_history=",0) == 0) { cfg.schedule_history = stripKey(arg, "schedule_history="); return true; }
+    else if (arg.rfind("journal=",0) == 0)      { cfg.journal = stripKey(arg, "journal="); return true; }
+    else if (arg.rfind("resume=",0) == 0)       { cfg.resume = stripKey(arg, "resume="); return true; }
+    else if (arg.rfind("replay_file=",0) == 0)  { cfg.replay_file = stripKey(arg, "replay_file="); return true; }
+    else if (arg.rfind("result_cache=",0) == 0) { cfg.result_cache = stripKey(arg, "result_cache="); return true; }
+    else if (arg.rfind("metrics_file=",0) == 0) { cfg.metrics_file = stripKey(arg, "metrics_file="); return true; }
+    else if (arg.rfind("metrics_interval_ms=",0) == 0) {
+        return parseMillis(stripKey(arg, "metrics_interval_ms="), cfg.metricsIntervalMs) && cfg.metricsIntervalMs > 0;
+    }
+    else if (arg.rfind("shard=",0) == 0)        { return parseShard(stripKey(arg, "shard="), cfg); }
+    else if (arg.rfind("decision_timeout_ms=",0) == 0) { return parseMillis(stripKey(arg, "decision_timeout_ms="), cfg.decisionTimeoutMs); }
+    else if (arg.rfind("game_timeout_ms=",0) == 0)     { return parseMillis(stripKey(arg, "game_timeout_ms="), cfg.gameTimeoutMs); }
+    else if (arg.rfind("isolation=",0) == 0) {
+        cfg.isolation = stripKey(arg, "isolation=");
+        return cfg.isolation == "thread" || cfg.isolation == "process";
+    }
+    else if (arg.rfind("scheduler=",0) == 0) {
+        cfg.scheduler = stripKey(arg, "scheduler=");
+        return cfg.scheduler == "fifo" || cfg.scheduler == "cost";
+    }
     
     return false;
 }
 
+// "<i>/<n>" with 0 <= i < n
+bool parseShard(const std::string& value, Config& cfg) {
+    const auto slash = value.find('/');
+    if (slash == std::string::npos || slash == 0 || slash + 1 == value.size()) return false;
+    const std::string index = value.substr(0, slash), count = value.substr(slash + 1);
+    auto isNumber = [](const std::string& s) { return std::all_of(s.begin(), s.end(), ::isdigit); };
+    if (!isNumber(index) || !isNumber(count) || index.size() > 9 || count.size() > 9) return false;
+    cfg.shardIndex = std::stoul(index);
+    cfg.shardCount = std::stoul(count);
+    return cfg.shardCount > 0 && cfg.shardIndex < cfg.shardCount;
+}
+
+// Non-negative milliseconds; 0 disables the limit
+bool parseMillis(const std::string& value, size_t& out) {
+    if (value.empty() || value.size() > 9 || !std::all_of(value.begin(), value.end(), ::isdigit)) return false;
+    out = std::stoul(value);
+    return true;
+}
+
 bool validateArguments(const Config& cfg, const std::vector<std::string>& unsupported, const char* prog) {
     return checkUnsupportedArgs(unsupported, prog) && 
            checkModeSelection(cfg, prog) && 
@@ -78,8 +128,8 @@ bool checkUnsupportedArgs(const std::vector<std::string>& unsupported, const cha
 }
 
 bool checkModeSelection(const Config& cfg, const char* prog) {
-    if (cfg.modeComparative == cfg.modeCompetition) {
-        std::cerr << "Error: must specify exactly one of -comparative or -competition\n\n";
+    if (int(cfg.modeComparative) + int(cfg.modeCompetition) + int(cfg.modeMerge) != 1) {
+        std::cerr << "Error: must specify exactly one of -comparative, -competition or -merge\n\n";
         printUsage(prog);
         return false;
     }
@@ -106,6 +156,8 @@ void collectMissingArgs(const Config& cfg, std::vector<std::string>& missing) {
         if (cfg.game_managers_folder.empty())   missing.push_back("game_managers_folder");
         if (cfg.algorithm1.empty())             missing.push_back("algorithm1");
         if (cfg.algorithm2.empty())             missing.push_back("algorithm2");
+    } else if (cfg.modeMerge) {
+        if (cfg.algorithms_folder.empty())      missing.push_back("algorithms_folder");
     } else {
         if (cfg.game_maps_folder.empty())       missing.push_back("game_maps_folder");
         if (cfg.game_manager.empty())           missing.push_back("game_manager");
@@ -116,6 +168,8 @@ void collectMissingArgs(const Config& cfg, std::vector<std::string>& missing) {
 bool validatePaths(const Config& cfg) {
     if (cfg.modeComparative) {
         return validateComparativePaths(cfg);
+    } else if (cfg.modeMerge) {
+        return validateMergePaths(cfg);
     } else {
         return validateCompetitionPaths(cfg);
     }
@@ -136,6 +190,10 @@ bool validateCompetitionPaths(const Config& cfg) {
            checkSoFiles(cfg.algorithms_folder, "algorithms_folder");
 }
 
+bool validateMergePaths(const Config& cfg) {
+    return mustBeDir(cfg.algorithms_folder, "algorithms_folder");
+}
+
 bool mustBeDir(const std::string& path, const char* name) {
     if (!fs::is_directory(path)) {
         std::string errorMsg = "Error: " + std::string(name) + " not a directory: " + path;
@@ -6,10 +6,31 @@
 struct Config {
     bool   modeComparative   = false;
     bool   modeCompetition   = false;
+    bool   modeMerge         = false;   // combine shard_<i>of<n>.txt files into one competition file
     bool   verbose           = false;
     bool   debug           = false;
+    bool   profile           = false;   // per-phase/algorithm timings -> profile_<ts>.txt (competition)
+    bool   keepFinalBoards   = false;   // competition: retain every GameResult incl. final board
     int    numThreads        = 1;
 
+    // optional, both modes
+    std::string map_cache;              // directory of compiled maps keyed by source hash
+    size_t      decisionTimeoutMs = 0;  // per getAction()/updateTankWithBattleInfo(); overrun forfeits the tank
+    size_t      gameTimeoutMs     = 0;  // per game; the player that used more of it forfeits (0 = unlimited)
+    std::string replay_file;            // -verbose games go to this binary container instead of log_*.txt files
+
+    // competition-only, optional
+    std::string scheduler = "fifo";     // "fifo" (file order) or "cost" (longest-expected-first)
+    std::string schedule_history;       // per-map game runtimes, read by scheduler=cost and updated after the run
+    std::string journal;                // append every finished game here
+    std::string resume;                 // skip games already in this journal (and keep appending to it)
+    std::string result_cache;           // directory of finished games keyed by map/plugin content hashes
+    std::string metrics_file;           // live progress in Prometheus text format, rewritten every interval
+    size_t      metricsIntervalMs = 1000;
+    std::string isolation = "thread";   // "thread" or "process" (games run in forked, respawned workers)
+    size_t      shardIndex = 0;         // shard=i/n: play only games hashed to shard i of n
+    size_t      shardCount = 1;
+
     // comparative-only
     std::string game_map;
     std::string game_managers_folder;
@@ -31,6 +52,8 @@ void printUsage(const char* prog);
 // Internal parsing helpers
 void parseArgumentsList(int argc, char* argv[], Config& cfg, std::vector<std::string>& unsupported);
 bool processArgument(const std::string& arg, Config& cfg);
+bool parseShard(const std::string& value, Config& cfg);
+bool parseMillis(const std::string& value, size_t& out);
 bool validateArguments(const Config& cfg, const std::vector<std::string>& unsupported, const char* prog);
 bool checkUnsupportedArgs(const std::vector<std::string>& unsupported, const char* prog);
 bool checkModeSelection(const Config& cfg, const char* prog);
@@ -39,6 +62,7 @@ void collectMissingArgs(const Config& cfg, std::vector<std::string>& missing);
 bool validatePaths(const Config& cfg);
 bool validateComparativePaths(const Config& cfg);
 bool validateCompetitionPaths(const Config& cfg);
+bool validateMergePaths(const Config& cfg);
 bool mustBeDir(const std::string& path, const char* name);
 bool mustBeFile(const std::string& path, const char* name);
 bool checkSoFiles(const std::string& dirPath, const char* name);
@@ -0,0 +1,125 @@
+// Simulator/CompetitionJournal.cpp
+#include "CompetitionJournal.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr const char* kHeader = "# competition journal v1\n";
+
+std::vector<std::string> splitTabs(const std::string& line) {
+    std::vector<std::string> out;
+    std::string field;
+    std::istringstream ss(line);
+    while (std::getline(ss, field, '\t')) out.push_back(field);
+    return out;
+}
+
+bool parseNumber(const std::string& s, long long& out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtoll(s.c_str(), &end, 10);
+    return errno == 0 && end && *end == '\0';
+}
+
+bool writeAll(int fd, const std::string& data) {
+    const char* p = data.data();
+    std::size_t left = data.size();
+    while (left > 0) {
+        const ssize_t n = ::write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+CompetitionJournal::~CompetitionJournal() {
+    close();
+}
+
+std::size_t CompetitionJournal::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    // Only newline-terminated lines are complete
+    text.resize(text.rfind('\n') == std::string::npos ? 0 : text.rfind('\n') + 1);
+
+    std::size_t skipped = 0;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        const auto f = splitTabs(line);
+        long long winner, reason, rounds;
+        if (f.size() != 8 || f[0] != "G" || !parseNumber(f[5], winner) ||
+            !parseNumber(f[6], reason) || !parseNumber(f[7], rounds) || winner < 0 || winner > 2 || rounds < 0) {
+            ++skipped;
+            continue;
+        }
+        done_[{f[1], f[2], f[3], f[4]}] = {int(winner), int(reason), std::size_t(rounds)};
+    }
+    return skipped;
+}
+
+bool CompetitionJournal::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) return false;
+
+    // Fresh file gets a header; a torn last line gets terminated
+    const off_t size = ::lseek(fd_, 0, SEEK_END);
+    char last = '\n';
+    if (size > 0) {
+        const int rfd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (rfd >= 0) {
+            if (::pread(rfd, &last, 1, size - 1) != 1) last = '\n';
+            ::close(rfd);
+        }
+    }
+    const bool ok = size == 0 ? writeAll(fd_, kHeader) : (last == '\n' || writeAll(fd_, "\n"));
+    lastSync_ = std::chrono::steady_clock::now();
+    return ok;
+}
+
+const JournalEntry* CompetitionJournal::find(const JournalKey& key) const {
+    auto it = done_.find(key);
+    return it == done_.end() ? nullptr : &it->second;
+}
+
+void CompetitionJournal::append(const JournalKey& key, const JournalEntry& e) {
+    const std::string line = "G\t" + key.gameManager + '\t' + key.map + '\t' + key.algo1 + '\t' + key.algo2 +
+                             '\t' + std::to_string(e.winner) + '\t' + std::to_string(e.reason) +
+                             '\t' + std::to_string(e.rounds) + '\n';
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) return;
+    writeAll(fd_, line);    // single write per line, so concurrent runs never interleave
+    if (++unsynced_ >= kSyncEvery || std::chrono::steady_clock::now() - lastSync_ >= kSyncInterval) {
+        syncLocked();
+    }
+}
+
+void CompetitionJournal::syncLocked() {
+    ::fdatasync(fd_);
+    unsynced_ = 0;
+    lastSync_ = std::chrono::steady_clock::now();
+}
+
+void CompetitionJournal::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) return;
+    syncLocked();
+    ::close(fd_);
+    fd_ = -1;
+}
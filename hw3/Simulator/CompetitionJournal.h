@@ -0,0 +1,69 @@
+// Simulator/CompetitionJournal.h
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/// Identity of one competition game. The map is its file name, so a
+/// journal stays valid if the maps folder is moved.
+struct JournalKey {
+    std::string gameManager, map, algo1, algo2;
+    bool operator<(const JournalKey& o) const {
+        return std::tie(gameManager, map, algo1, algo2) < std::tie(o.gameManager, o.map, o.algo1, o.algo2);
+    }
+};
+
+struct JournalEntry {
+    int         winner = 0;
+    int         reason = 0;
+    std::size_t rounds = 0;
+};
+
+/// Append-only record of finished competition games (journal=<file>).
+///
+/// One tab-separated line per game:
+///     G <gm> <map> <algo1> <algo2> <winner> <reason> <rounds>
+/// Each line is handed to the kernel as soon as the game finishes; fdatasync
+/// runs every kSyncEvery games or kSyncInterval, and on close. A line torn
+/// by a crash is ignored on load, and appending starts on a fresh line.
+class CompetitionJournal {
+public:
+    static constexpr std::size_t kSyncEvery = 64;
+    static constexpr std::chrono::seconds kSyncInterval{2};
+
+    CompetitionJournal() = default;
+    ~CompetitionJournal();
+    CompetitionJournal(const CompetitionJournal&) = delete;
+    CompetitionJournal& operator=(const CompetitionJournal&) = delete;
+
+    /// Read every complete entry of `path` (a missing file is empty).
+    /// Returns the number of lines that were skipped as malformed.
+    std::size_t load(const std::string& path);
+
+    /// Open `path` for appending; false on failure.
+    bool open(const std::string& path);
+
+    /// Entry for `key` loaded from disk, or null.
+    const JournalEntry* find(const JournalKey& key) const;
+    std::size_t loadedCount() const { return done_.size(); }
+
+    /// Thread-safe.
+    void append(const JournalKey& key, const JournalEntry& e);
+
+    /// Sync and close; safe to call twice.
+    void close();
+
+private:
+    void syncLocked();
+
+    std::map<JournalKey, JournalEntry> done_;     // read-only after load()
+
+    std::mutex  mutex_;
+    int         fd_ = -1;
+    std::size_t unsynced_ = 0;
+    std::chrono::steady_clock::time_point lastSync_;
+};
@@ -0,0 +1,119 @@
+// Simulator/CompetitionMetrics.cpp
+#include "CompetitionMetrics.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+// "# HELP" / "# TYPE" header of one metric family
+void family(std::ostream& os, const char* name, const char* type, const char* help) {
+    os << "# HELP " << name << ' ' << help << '\n'
+       << "# TYPE " << name << ' ' << type << '\n';
+}
+
+template <typename T>
+void sample(std::ostream& os, const char* name, const char* type, const char* help, T value) {
+    family(os, name, type, help);
+    os << name << ' ' << value << '\n';
+}
+
+} // namespace
+
+MetricsReporter::MetricsReporter(std::string path, std::chrono::milliseconds interval,
+                                 const CompetitionMetrics& metrics, const ThreadPool& pool)
+    : path_(std::move(path)), interval_(interval), metrics_(metrics), pool_(pool),
+      start_(Clock::now()), lastAt_(start_) {
+    for (const auto& s : pool_.stats()) lastIdle_.push_back(s.idle);
+    thread_ = std::thread([this] { run(); });
+}
+
+MetricsReporter::~MetricsReporter() {
+    stop();
+}
+
+void MetricsReporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!cond_.wait_for(lock, interval_, [this] { return stop_; })) {
+        lock.unlock();
+        writeSnapshot();
+        lock.lock();
+    }
+}
+
+bool MetricsReporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) return true;
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    return writeSnapshot();
+}
+
+bool MetricsReporter::writeSnapshot() {
+    std::lock_guard<std::mutex> hold(snapshotMutex_);
+    return writeFileAtomically(path_, render());
+}
+
+std::string MetricsReporter::render() {
+    const auto now = Clock::now();
+    const std::uint64_t queued    = metrics_.queued.load(std::memory_order_relaxed);
+    const std::uint64_t completed = metrics_.completed.load(std::memory_order_relaxed);
+    const std::uint64_t failed    = metrics_.failed.load(std::memory_order_relaxed);
+    const std::uint64_t finished  = completed + failed;
+    const double uptime = seconds(now - start_);
+    const double window = seconds(now - lastAt_);
+
+    // Recent rate for spotting stalls; the run average for the ETA
+    const double recentRate = window > 0 ? double(finished - lastFinished_) / window : 0.0;
+    const double averageRate = uptime > 0 ? double(finished) / uptime : 0.0;
+    const std::uint64_t remaining = queued > finished ? queued - finished : 0;
+    const double eta = remaining == 0 ? 0.0 : averageRate > 0 ? double(remaining) / averageRate : -1.0;
+
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    sample(os, "simulator_uptime_seconds", "gauge", "Seconds since the competition started.", uptime);
+    sample(os, "simulator_games_queued_total", "counter", "Games handed to the worker pool.", queued);
+    sample(os, "simulator_games_completed_total", "counter", "Games played and scored.", completed);
+    sample(os, "simulator_games_failed_total", "counter", "Games that threw, crashed or timed out in a worker process.", failed);
+    family(os, "simulator_games_skipped_total", "counter", "Games taken from earlier runs instead of played.");
+    os << "simulator_games_skipped_total{source=\"journal\"} " << metrics_.resumed.load(std::memory_order_relaxed) << '\n'
+       << "simulator_games_skipped_total{source=\"cache\"} " << metrics_.cached.load(std::memory_order_relaxed) << '\n';
+    sample(os, "simulator_games_in_flight", "gauge", "Games running right now.", metrics_.inFlight.load(std::memory_order_relaxed));
+    sample(os, "simulator_games_per_second", "gauge", "Games finished per second over the last interval.", recentRate);
+    sample(os, "simulator_games_per_second_average", "gauge", "Games finished per second since the start.", averageRate);
+    sample(os, "simulator_all_games_queued", "gauge", "1 once every map is loaded and every game queued; until then the ETA covers only queued games.",
+           metrics_.allQueued.load(std::memory_order_relaxed) ? 1 : 0);
+    sample(os, "simulator_eta_seconds", "gauge", "Estimated seconds until the queued games finish, -1 if unknown.", eta);
+    sample(os, "simulator_queue_depth", "gauge", "Pool tasks waiting for a worker.", pool_.queueDepth());
+
+    const auto stats = pool_.stats();
+    lastIdle_.resize(stats.size(), std::chrono::nanoseconds::zero());
+    family(os, "simulator_worker_utilization", "gauge", "Share of the last interval each pool worker spent running tasks.");
+    for (size_t w = 0; w < stats.size(); ++w) {
+        const double idle = seconds(stats[w].idle - lastIdle_[w]);
+        const double busy = window > 0 ? std::clamp(1.0 - idle / window, 0.0, 1.0) : 0.0;
+        os << "simulator_worker_utilization{worker=\"" << w << "\"} " << busy << '\n';
+        lastIdle_[w] = stats[w].idle;
+    }
+    family(os, "simulator_worker_tasks_total", "counter", "Pool tasks run by each worker (map loads and games).");
+    for (size_t w = 0; w < stats.size(); ++w) {
+        os << "simulator_worker_tasks_total{worker=\"" << w << "\"} " << stats[w].tasksRun << '\n';
+    }
+
+    lastAt_ = now;
+    lastFinished_ = finished;
+    return os.str();
+}
@@ -0,0 +1,83 @@
+// Simulator/CompetitionMetrics.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ThreadPool;
+
+/// Live counters of a running competition. Game tasks bump them with
+/// relaxed atomics; the reporter reads them without stopping anyone.
+struct CompetitionMetrics {
+    std::atomic<std::uint64_t> queued{0};      // games handed to the pool
+    std::atomic<std::uint64_t> completed{0};   // played and scored
+    std::atomic<std::uint64_t> failed{0};      // threw, crashed or timed out in a worker process
+    std::atomic<std::uint64_t> resumed{0};     // taken from the resume journal
+    std::atomic<std::uint64_t> cached{0};      // taken from the result cache
+    std::atomic<std::int64_t>  inFlight{0};
+    std::atomic<bool>          allQueued{false};   // every map loaded and every game queued
+
+    /// Counts one game as in flight; it ends as failed unless ok is set.
+    struct GameScope {
+        CompetitionMetrics& m;
+        bool ok = false;
+        explicit GameScope(CompetitionMetrics& metrics) : m(metrics) { m.inFlight.fetch_add(1, std::memory_order_relaxed); }
+        ~GameScope() {
+            (ok ? m.completed : m.failed).fetch_add(1, std::memory_order_relaxed);
+            m.inFlight.fetch_sub(1, std::memory_order_relaxed);
+        }
+        GameScope(const GameScope&) = delete;
+        GameScope& operator=(const GameScope&) = delete;
+    };
+};
+
+/// Writes the metrics, with the thread pool's load, to a file in Prometheus
+/// text format every interval (metrics_file=<path>); a node_exporter
+/// textfile collector or a plain `watch cat` can follow a long run. Each
+/// snapshot goes to a temporary file that is renamed over the target, so a
+/// reader never sees a partial one. A final snapshot is written on stop().
+class MetricsReporter {
+public:
+    MetricsReporter(std::string path, std::chrono::milliseconds interval,
+                    const CompetitionMetrics& metrics, const ThreadPool& pool);
+    ~MetricsReporter();
+    MetricsReporter(const MetricsReporter&) = delete;
+    MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+    /// Stop the thread and write the final snapshot; false if that failed.
+    bool stop();
+
+    const std::string& path() const { return path_; }
+
+    /// While the returned lock lives no snapshot is being rendered or
+    /// written, so the reporter thread holds no lock a fork() could copy.
+    std::unique_lock<std::mutex> holdSnapshots() { return std::unique_lock<std::mutex>(snapshotMutex_); }
+
+private:
+    void run();
+    bool writeSnapshot();
+    std::string render();
+
+    std::string                      path_;
+    std::chrono::milliseconds        interval_;
+    const CompetitionMetrics&        metrics_;
+    const ThreadPool&                pool_;
+    std::chrono::steady_clock::time_point start_;
+
+    // Previous snapshot, for rates over the last interval (reporter thread only)
+    std::chrono::steady_clock::time_point lastAt_;
+    std::uint64_t                    lastFinished_ = 0;
+    std::vector<std::chrono::nanoseconds> lastIdle_;
+
+    std::mutex              snapshotMutex_;   // held by writeSnapshot()
+    std::mutex              mutex_;
+    std::condition_variable cond_;
+    bool                    stop_ = false;
+    std::thread             thread_;
+};
@@ -0,0 +1,108 @@
+// Simulator/CostScheduler.cpp
+#include "CostScheduler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <sstream>
+
+#include "MappedFile.h"
+
+CostScheduler::CostScheduler(std::string historyPath) : historyPath_(std::move(historyPath)) {
+    if (!historyPath_.empty()) loadHistory();
+}
+
+// History lines: "<avg_ns> <samples> <map key>" (the key is the rest of the line)
+void CostScheduler::loadHistory() {
+    std::ifstream in(historyPath_);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        MapHistory h;
+        std::string key;
+        if (!(ss >> h.avgNs >> h.samples)) continue;
+        std::getline(ss >> std::ws, key);
+        if (!key.empty() && h.samples > 0) history_[key] = h;
+    }
+}
+
+double CostScheduler::modelUnits(std::size_t rows, std::size_t cols, std::size_t tanks, std::size_t maxSteps) {
+    return double(maxSteps) * (double(rows) * double(cols) + kTankWeight * double(tanks));
+}
+
+void CostScheduler::calibrate(const std::vector<std::pair<std::string, double>>& mapUnits) {
+    double ns = 0, units = 0;
+    for (const auto& [key, u] : mapUnits) {
+        auto it = history_.find(key);
+        if (it == history_.end() || u <= 0) continue;
+        ns += it->second.avgNs;
+        units += u;
+    }
+    if (units > 0 && ns > 0) nsPerUnit_ = ns / units;
+}
+
+double CostScheduler::predictNs(const std::string& mapKey, double units) const {
+    auto it = history_.find(mapKey);
+    if (it != history_.end()) return it->second.avgNs;
+    return units * nsPerUnit_;
+}
+
+void CostScheduler::order(std::vector<ScheduledGame>& games) {
+    std::stable_sort(games.begin(), games.end(), [](const ScheduledGame& a, const ScheduledGame& b) {
+        if (a.predictedNs != b.predictedNs) return a.predictedNs > b.predictedNs;
+        return a.map < b.map;
+    });
+}
+
+double CostScheduler::predictMakespanNs(const std::vector<ScheduledGame>& games, std::size_t workers) {
+    if (workers == 0) workers = 1;
+    std::priority_queue<double, std::vector<double>, std::greater<double>> freeAt;
+    for (std::size_t w = 0; w < workers; ++w) freeAt.push(0.0);
+    double makespan = 0;
+    for (const auto& g : games) {
+        const double end = freeAt.top() + g.predictedNs;
+        freeAt.pop();
+        freeAt.push(end);
+        makespan = std::max(makespan, end);
+    }
+    return makespan;
+}
+
+void CostScheduler::record(const std::string& mapKey, std::uint64_t ns) {
+    std::lock_guard<std::mutex> lock(runMutex_);
+    auto& r = run_[mapKey];
+    r.first += ns;
+    ++r.second;
+}
+
+std::uint64_t CostScheduler::runTotalNs() const {
+    std::lock_guard<std::mutex> lock(runMutex_);
+    std::uint64_t total = 0;
+    for (const auto& [key, r] : run_) total += r.first;
+    return total;
+}
+
+bool CostScheduler::saveHistory() const {
+    if (historyPath_.empty()) return false;
+
+    std::map<std::string, MapHistory> merged = history_;
+    {
+        std::lock_guard<std::mutex> lock(runMutex_);
+        for (const auto& [key, r] : run_) {
+            MapHistory& h = merged[key];
+            const std::size_t oldSamples = std::min(h.samples, kMaxSamples - std::min(r.second, kMaxSamples));
+            const double total = h.avgNs * double(oldSamples) + double(r.first);
+            h.samples = oldSamples + r.second;
+            h.avgNs = total / double(h.samples);
+        }
+    }
+
+    std::ostringstream out;
+    out << "# avg_game_ns samples map\n";
+    for (const auto& [key, h] : merged) {
+        out << static_cast<std::uint64_t>(h.avgNs) << ' ' << h.samples << ' ' << key << '\n';
+    }
+    return writeFileAtomically(historyPath_, out.str());
+}
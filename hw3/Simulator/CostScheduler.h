@@ -0,0 +1,77 @@
+// Simulator/CostScheduler.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// One competition game as seen by the scheduler.
+struct ScheduledGame {
+    std::size_t map;          // index into the loaded-map slots
+    std::size_t mapIndex;     // index among valid maps (decides pairings)
+    std::size_t i, j;         // algorithm indices
+    double      predictedNs;
+};
+
+/// Longest-expected-first scheduling for competition games.
+///
+/// A game's cost is predicted from the measured average of earlier runs on
+/// the same map (schedule_history=<file>) or, for unseen maps, from
+///     MaxSteps * (rows*cols + kTankWeight * tanks)
+/// scaled by the ns-per-unit ratio fitted on the maps that do have history.
+/// Games are then ordered by predicted cost, keeping each map's games
+/// contiguous so a worker draining a batch tends to stay on one map.
+class CostScheduler {
+public:
+    static constexpr double kTankWeight     = 64.0;
+    static constexpr double kDefaultNsPerUnit = 1.5;   // rough fit on the sample maps
+
+    /// Reads `path` if it exists; an empty path disables history.
+    explicit CostScheduler(std::string historyPath);
+
+    /// Structural cost units for a map with no history.
+    static double modelUnits(std::size_t rows, std::size_t cols, std::size_t tanks, std::size_t maxSteps);
+
+    /// Fit ns-per-unit on the maps of this run that have history; call once
+    /// with every map's key and model units before predictNs().
+    void calibrate(const std::vector<std::pair<std::string, double>>& mapUnits);
+
+    double predictNs(const std::string& mapKey, double units) const;
+
+    /// Sort by predicted cost (descending), map order breaking ties.
+    static void order(std::vector<ScheduledGame>& games);
+
+    /// Greedy list-scheduling makespan of `games` in order on `workers`.
+    static double predictMakespanNs(const std::vector<ScheduledGame>& games, std::size_t workers);
+
+    /// Thread-safe: add one measured game.
+    void record(const std::string& mapKey, std::uint64_t ns);
+
+    /// Merge this run's measurements into the history file (atomic replace).
+    bool saveHistory() const;
+
+    /// Sum of this run's measured game times.
+    std::uint64_t runTotalNs() const;
+
+    double nsPerUnit() const { return nsPerUnit_; }
+    const std::string& historyPath() const { return historyPath_; }
+
+private:
+    struct MapHistory {
+        double      avgNs = 0;
+        std::size_t samples = 0;
+    };
+    static constexpr std::size_t kMaxSamples = 32;   // older runs fade out
+
+    void loadHistory();
+
+    std::string                       historyPath_;
+    std::map<std::string, MapHistory> history_;     // from disk, read-only after construction
+    double                            nsPerUnit_ = kDefaultNsPerUnit;
+
+    mutable std::mutex                                         runMutex_;
+    std::map<std::string, std::pair<std::uint64_t, std::size_t>> run_;   // key -> (sum ns, games)
+};
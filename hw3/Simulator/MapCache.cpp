@@ -0,0 +1,93 @@
+// Simulator/MapCache.cpp
+#include "MapCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char          kMagic[8] = {'T', 'N', 'K', 'M', 'A', 'P', '\0', '\1'};
+constexpr std::uint32_t kVersion  = 1;
+
+static_assert(std::is_trivially_copyable_v<MapCacheHeader>, "MapCacheHeader is written raw");
+
+// Read-only view over the cells of a mapped cache entry
+class CachedMapView : public SatelliteView {
+public:
+    CachedMapView(MappedFile&& file, const char* cells, size_t width, size_t height)
+        : file_(std::move(file)), cells_(cells), width_(width), height_(height) {}
+    char getObjectAt(size_t x, size_t y) const override {
+        return (y < height_ && x < width_) ? cells_[y * width_ + x] : ' ';
+    }
+private:
+    MappedFile  file_;
+    const char* cells_;
+    size_t      width_, height_;
+};
+
+} // namespace
+
+MapCache::MapCache(std::string dir) : dir_(std::move(dir)) {}
+
+std::uint64_t MapCache::hashSource(std::string_view bytes) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : bytes) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+MapCacheHeader MapCache::makeHeader(std::uint64_t hash, std::size_t sourceSize) {
+    MapCacheHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version    = kVersion;
+    h.headerSize = sizeof(MapCacheHeader);
+    h.sourceHash = hash;
+    h.sourceSize = sourceSize;
+    return h;
+}
+
+std::string MapCache::pathFor(std::uint64_t hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.tmc", static_cast<unsigned long long>(hash));
+    return (fs::path(dir_) / name).string();
+}
+
+bool MapCache::lookup(std::uint64_t hash, std::size_t sourceSize, Entry& out) const {
+    MappedFile file;
+    if (!file.open(pathFor(hash)) || file.size() < sizeof(MapCacheHeader)) return false;
+
+    const auto* h = reinterpret_cast<const MapCacheHeader*>(file.view().data());
+    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 || h->version != kVersion ||
+        h->headerSize != sizeof(MapCacheHeader) || h->sourceHash != hash ||
+        h->sourceSize != sourceSize || h->rows == 0 || h->cols == 0 ||
+        h->cols > (file.size() - sizeof(MapCacheHeader)) / h->rows ||
+        file.size() != sizeof(MapCacheHeader) + h->rows * h->cols) {
+        return false;
+    }
+    out.file   = std::move(file);
+    out.header = h;            // the mapping address survives the move
+    return true;
+}
+
+bool MapCache::store(const MapCacheHeader& header, std::string_view cells) const {
+    std::string bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes.append(cells);
+    return writeFileAtomically(pathFor(header.sourceHash), bytes);
+}
+
+std::string_view MapCache::Entry::cells() const {
+    return {file.view().data() + sizeof(MapCacheHeader), header->rows * header->cols};
+}
+
+std::unique_ptr<SatelliteView> MapCache::Entry::takeView() {
+    const char* cellData = cells().data();
+    const size_t width = header->cols, height = header->rows;
+    header = nullptr;
+    return std::make_unique<CachedMapView>(std::move(file), cellData, width, height);
+}
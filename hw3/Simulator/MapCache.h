@@ -0,0 +1,60 @@
+// Simulator/MapCache.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "MappedFile.h"
+#include "SatelliteView.h"
+
+/// On-disk layout of a compiled map: this header followed directly by
+/// rows*cols normalized cells (one char each, row-major, no padding).
+/// Besides the map itself it keeps what the source file looked like, so the
+/// same dimension/character warnings can be reported on a cache hit.
+struct MapCacheHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t sourceHash;
+    std::uint64_t sourceSize;
+    std::uint64_t rows, cols, maxSteps, numShells;
+    std::uint64_t fileRows, maxFileCols;     // grid lines / longest line in the source
+    std::uint64_t invalidChars[4];           // 256-bit set of replaced byte values
+};
+
+/// Compiled-map cache in one directory, one file per source content hash
+/// (<16 hex digits>.tmc). Entries are written to a temporary name and
+/// renamed into place, so concurrent runs and loader threads never see a
+/// partial file; anything that fails validation is treated as a miss.
+class MapCache {
+public:
+    explicit MapCache(std::string dir);
+
+    const std::string& dir() const { return dir_; }
+
+    /// FNV-1a over the source bytes.
+    static std::uint64_t hashSource(std::string_view bytes);
+
+    /// A validated cache entry; cells() points into the mapping.
+    struct Entry {
+        MappedFile            file;
+        const MapCacheHeader* header = nullptr;
+        std::string_view cells() const;
+        /// Zero-copy SatelliteView over the mapped cells; owns the mapping.
+        std::unique_ptr<SatelliteView> takeView();
+    };
+
+    bool lookup(std::uint64_t hash, std::size_t sourceSize, Entry& out) const;
+    bool store(const MapCacheHeader& header, std::string_view cells) const;
+
+    /// Header with magic/version/size already filled in.
+    static MapCacheHeader makeHeader(std::uint64_t hash, std::size_t sourceSize);
+
+private:
+    std::string pathFor(std::uint64_t hash) const;
+
+    std::string dir_;
+};
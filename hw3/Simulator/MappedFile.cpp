@@ -0,0 +1,87 @@
+// Simulator/MappedFile.cpp
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_   = std::exchange(other.data_, nullptr);
+        size_   = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    release();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {          // mmap rejects zero length
+        ::close(fd);
+        return true;
+    }
+
+    void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);                    // the mapping keeps the file alive
+    if (p == MAP_FAILED) return false;
+
+    ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+    data_   = static_cast<const char*>(p);
+    size_   = static_cast<std::size_t>(st.st_size);
+    mapped_ = true;
+    return true;
+}
+
+void MappedFile::release() {
+    if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+    data_   = nullptr;
+    size_   = 0;
+    mapped_ = false;
+}
+
+bool writeFileAtomically(const std::string& path, std::string_view bytes) {
+    const std::string tmpPath = path + ".tmp." + std::to_string(::getpid()) + "." +
+                                std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        out.close();
+        if (!out) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
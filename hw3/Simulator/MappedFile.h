@@ -0,0 +1,38 @@
+// Simulator/MappedFile.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/// Read-only memory mapping of a whole file. Empty files map to an empty
+/// view without calling mmap. Move-only; unmaps on destruction.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map `path`; returns false (and leaves the object empty) on any failure.
+    bool open(const std::string& path);
+
+    std::string_view view() const { return {data_, size_}; }
+    std::size_t size() const { return size_; }
+
+private:
+    void release();
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool        mapped_ = false;
+};
+
+/// Write `bytes` to a temporary file next to `path` (named with the pid and
+/// thread id, so concurrent writers never share one) and rename it into
+/// place, so readers see the old file or the new one, never a partial one.
+/// The temporary is removed on any failure.
+bool writeFileAtomically(const std::string& path, std::string_view bytes);
@@ -0,0 +1,258 @@
+// Simulator/ProcessPool.cpp
+#include "ProcessPool.h"
+#include "GameLimits.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+bool writeWord(int fd, std::uint64_t v) {
+    for (;;) {
+        const ssize_t n = ::write(fd, &v, sizeof(v));
+        if (n == sizeof(v)) return true;
+        if (n < 0 && errno == EINTR) continue;
+        return false;
+    }
+}
+
+// False on EOF or error
+bool readWord(int fd, std::uint64_t& v) {
+    for (;;) {
+        const ssize_t n = ::read(fd, &v, sizeof(v));
+        if (n == sizeof(v)) return true;
+        if (n < 0 && errno == EINTR) continue;
+        return false;
+    }
+}
+
+void closeAll(std::vector<int>& fds) {
+    for (int& fd : fds) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+}
+
+void setError(IsolatedGameOutcome& out, const std::string& msg) {
+    std::snprintf(out.error, sizeof(out.error), "%s", msg.c_str());
+}
+
+std::string describeExit(int status) {
+    if (WIFSIGNALED(status)) {
+        const int sig = WTERMSIG(status);
+        return "worker killed by signal " + std::to_string(sig) + " (" + ::strsignal(sig) + ")";
+    }
+    return "worker exited with status " + std::to_string(WEXITSTATUS(status));
+}
+
+} // namespace
+
+ProcessPool::ProcessPool(std::size_t workers, Runner runner)
+    : numWorkers_(workers ? workers : 1), runner_(std::move(runner)),
+      reqRead_(numWorkers_, -1), reqWrite_(numWorkers_, -1),
+      doneRead_(numWorkers_, -1), doneWrite_(numWorkers_, -1) {
+    void* mem = ::mmap(nullptr, sizeof(Slot) * numWorkers_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return;
+    slots_ = static_cast<Slot*>(mem);
+    for (std::size_t w = 0; w < numWorkers_; ++w) new (&slots_[w]) Slot();
+    std::signal(SIGPIPE, SIG_IGN);   // a vanished pool must show up as a write error, not kill us
+
+    for (std::size_t w = 0; w < numWorkers_; ++w) {
+        int req[2], done[2];
+        if (::pipe2(req, O_CLOEXEC) != 0 || ::pipe2(done, O_CLOEXEC) != 0) return;
+        reqRead_[w] = req[0];  reqWrite_[w] = req[1];
+        doneRead_[w] = done[0]; doneWrite_[w] = done[1];
+    }
+
+    serverPid_ = ::fork();
+    if (serverPid_ == 0) serverMain();
+    // Parent keeps only its ends, so worker exits surface as EOF/answers
+    closeAll(reqRead_);
+    closeAll(doneWrite_);
+    for (std::size_t w = 0; w < numWorkers_; ++w) freeWorkers_.push_back(w);
+}
+
+ProcessPool::~ProcessPool() {
+    shutdown();
+    if (slots_) ::munmap(slots_, sizeof(Slot) * numWorkers_);
+}
+
+void ProcessPool::shutdown() {
+    closeAll(reqWrite_);           // workers see EOF and exit 0; the server then runs out of children
+    if (serverPid_ > 0) {
+        int status = 0;
+        while (::waitpid(serverPid_, &status, 0) < 0 && errno == EINTR) {}
+        serverPid_ = -1;
+    }
+    closeAll(doneRead_);
+}
+
+// ---------- fork-server ----------
+
+void ProcessPool::serverMain() {
+    closeAll(reqWrite_);
+    closeAll(doneRead_);
+    std::vector<pid_t> pids(numWorkers_, -1);
+    for (std::size_t w = 0; w < numWorkers_; ++w) pids[w] = spawnWorker(w);
+
+    for (;;) {
+        int status = 0;
+        const pid_t pid = ::waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;                                  // ECHILD: every worker has exited
+        }
+        std::size_t w = 0;
+        while (w < numWorkers_ && pids[w] != pid) ++w;
+        if (w == numWorkers_) continue;
+        pids[w] = -1;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) continue;   // clean shutdown
+
+        // Answer for the dead worker, then replace it
+        Slot& slot = slots_[w];
+        slot.out = IsolatedGameOutcome{};
+        if (WIFEXITED(status) && WEXITSTATUS(status) == UserCommon_315634022::kHangExitStatus) {
+            slot.out.status = IsolatedGameOutcome::TIMED_OUT;   // the GameManager's watchdog gave up on a call
+            setError(slot.out, "worker ended itself: an algorithm call never returned");
+        } else {
+            slot.out.status = IsolatedGameOutcome::CRASHED;
+            setError(slot.out, describeExit(status));
+        }
+        writeWord(doneWrite_[w], (slot.req.seq << 1) | 1);
+        pids[w] = spawnWorker(w);
+    }
+    ::_exit(0);
+}
+
+pid_t ProcessPool::spawnWorker(std::size_t w) {
+    const pid_t pid = ::fork();
+    if (pid == 0) workerMain(w);
+    return pid;
+}
+
+// ---------- worker ----------
+
+void ProcessPool::workerMain(std::size_t w) {
+    for (std::size_t k = 0; k < numWorkers_; ++k) {
+        if (k != w) {
+            ::close(reqRead_[k]);
+            ::close(doneWrite_[k]);
+        }
+    }
+    slots_[w].pid = ::getpid();
+    std::uint64_t seq = 0;
+    while (readWord(reqRead_[w], seq)) {
+        Slot& slot = slots_[w];
+        try {
+            slot.out = runner_(slot.req);
+        } catch (const std::exception& ex) {
+            slot.out = IsolatedGameOutcome{};
+            setError(slot.out, ex.what());
+        } catch (...) {
+            slot.out = IsolatedGameOutcome{};
+            setError(slot.out, "Unknown error occurred.");
+        }
+        std::cout.flush();
+        std::fflush(nullptr);
+        if (!writeWord(doneWrite_[w], seq << 1)) break;
+    }
+    ::_exit(0);   // no destructors: they belong to the parent's objects
+}
+
+// ---------- parent ----------
+
+size_t ProcessPool::acquireWorker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    freeCond_.wait(lock, [this] { return !freeWorkers_.empty(); });
+    const size_t w = freeWorkers_.back();
+    freeWorkers_.pop_back();
+    return w;
+}
+
+void ProcessPool::releaseWorker(size_t w) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeWorkers_.push_back(w);
+    }
+    freeCond_.notify_one();
+}
+
+IsolatedGameOutcome ProcessPool::run(std::size_t map, std::size_t i, std::size_t j,
+                                     std::chrono::milliseconds hardLimit) {
+    IsolatedGameOutcome out;
+    if (!ok()) {
+        out.status = IsolatedGameOutcome::CRASHED;
+        setError(out, "worker pool unavailable");
+        return out;
+    }
+    const size_t w = acquireWorker();
+    std::uint64_t seq;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        seq = nextSeq_++;
+    }
+    slots_[w].req = {seq, map, i, j};
+
+    bool crashed = false, killed = false;
+    const bool answered = writeWord(reqWrite_[w], seq) && awaitAnswer(w, seq, hardLimit, crashed, killed);
+    if (answered && killed) {
+        out.status = IsolatedGameOutcome::TIMED_OUT;
+        setError(out, "worker killed after the hard limit of " + std::to_string(hardLimit.count()) + " ms");
+    } else if (answered) {
+        out = slots_[w].out;
+    } else {
+        out.status = IsolatedGameOutcome::CRASHED;
+        setError(out, "worker pool unavailable");
+    }
+    if (crashed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++crashes_;
+    }
+    releaseWorker(w);
+    return out;
+}
+
+// Wait for the answer to `seq`, skipping ones left over from a worker that
+// died while idle. Past the hard limit the worker is killed; the fork-server
+// then answers for it as for any crash.
+bool ProcessPool::awaitAnswer(size_t w, std::uint64_t seq, std::chrono::milliseconds hardLimit,
+                              bool& crashed, bool& killed) {
+    const auto deadline = std::chrono::steady_clock::now() + hardLimit;
+    for (;;) {
+        if (hardLimit.count() > 0 && !killed) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            pollfd pfd{doneRead_[w], POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, static_cast<int>(std::max<std::int64_t>(left.count(), 0)));
+            if (ready < 0 && errno == EINTR) continue;
+            if (ready == 0) {
+                killed = true;
+                if (slots_[w].pid > 0) ::kill(slots_[w].pid, SIGKILL);
+                continue;
+            }
+        }
+        std::uint64_t msg = 0;
+        if (!readWord(doneRead_[w], msg)) return false;
+        if ((msg >> 1) != seq) continue;
+        crashed = msg & 1;
+        if (!crashed) killed = false;   // finished just before the kill landed
+        return true;
+    }
+}
+
+std::size_t ProcessPool::crashes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return crashes_;
+}
@@ -0,0 +1,104 @@
+// Simulator/ProcessPool.h
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+
+#include "GameProfile.h"
+
+/// One game handed to a worker process. `map` is whatever the runner uses
+/// to find the map in the memory the workers inherited.
+struct IsolatedGameRequest {
+    std::uint64_t seq = 0;
+    std::size_t   map = 0, i = 0, j = 0;
+};
+
+struct IsolatedGameOutcome {
+    enum Status : int { OK, ERROR, CRASHED, TIMED_OUT };
+    Status      status = ERROR;
+    int         winner = 0, reason = 0;
+    std::size_t rounds = 0;
+    bool        hasProfile = false;
+    UserCommon_315634022::GameProfile profile{};
+    char        error[256] = {};   // ERROR: exception text; CRASHED/TIMED_OUT: how the worker died
+    char        timeout[256] = {};  // OK: the GameManager's note if a time budget ran out
+};
+
+/// Crash-isolated game execution (isolation=process).
+///
+/// The constructor forks a fork-server, which forks `workers` game
+/// processes. All of them inherit the already-loaded plugins and maps, so
+/// nothing is loaded twice. Each worker owns one slot in a shared anonymous
+/// mapping. A request is written to the slot and announced over the
+/// worker's request pipe; the worker writes the outcome back to the slot
+/// and answers on its done pipe.
+///
+/// The fork-server only reaps workers. When one dies it records the cause
+/// in the slot, answers for the worker (so the waiting caller gets
+/// CRASHED instead of blocking), and forks a replacement. The fork-server
+/// itself is forked from the caller, so the caller must fork while no
+/// other thread holds a lock the children use. The fork-server is
+/// single-threaded, so replacement workers inherit only that state.
+///
+/// run() is thread-safe and blocks; callers beyond `workers` wait for a
+/// free worker. With a hard limit, a game still running when it passes has
+/// its worker SIGKILLed and comes back TIMED_OUT; so does one whose worker
+/// exits with kHangExitStatus (GameLimits.h).
+class ProcessPool {
+public:
+    using Runner = std::function<IsolatedGameOutcome(const IsolatedGameRequest&)>;
+
+    /// Flush stdio before constructing: the children inherit its buffers.
+    ProcessPool(std::size_t workers, Runner runner);
+    ~ProcessPool();
+    ProcessPool(const ProcessPool&) = delete;
+    ProcessPool& operator=(const ProcessPool&) = delete;
+
+    /// False if the fork-server could not be started.
+    bool ok() const { return serverPid_ > 0; }
+
+    IsolatedGameOutcome run(std::size_t map, std::size_t i, std::size_t j,
+                            std::chrono::milliseconds hardLimit = std::chrono::milliseconds::zero());
+
+    /// Workers that died and were replaced so far.
+    std::size_t crashes() const;
+
+    /// Let workers finish and reap the fork-server; called by the destructor.
+    void shutdown();
+
+private:
+    struct Slot {
+        IsolatedGameRequest req;
+        IsolatedGameOutcome out;
+        pid_t               pid = -1;   // current worker, written by the worker itself
+    };
+    bool awaitAnswer(size_t w, std::uint64_t seq, std::chrono::milliseconds hardLimit,
+                     bool& crashed, bool& killed);
+
+    // Fork-server and worker sides; never return
+    [[noreturn]] void serverMain();
+    [[noreturn]] void workerMain(std::size_t w);
+    pid_t spawnWorker(std::size_t w);
+
+    size_t acquireWorker();
+    void releaseWorker(size_t w);
+
+    std::size_t numWorkers_;
+    Runner      runner_;
+    Slot*       slots_ = nullptr;               // shared mapping, one slot per worker
+    std::vector<int> reqRead_, reqWrite_;       // parent -> worker: request seq
+    std::vector<int> doneRead_, doneWrite_;     // worker/server -> parent: (seq << 1) | crashed
+    pid_t       serverPid_ = -1;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable freeCond_;
+    std::vector<size_t>     freeWorkers_;
+    std::uint64_t           nextSeq_ = 1;
+    std::size_t             crashes_ = 0;
+};
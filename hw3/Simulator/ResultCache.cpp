@@ -0,0 +1,127 @@
+// Simulator/ResultCache.cpp
+#include "ResultCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "MapCache.h"
+#include "MappedFile.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kHeader = "# game result cache v1";
+
+std::string hex(std::uint64_t v) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+    return buf;
+}
+
+// Final board read back from an entry
+class CachedBoardView : public SatelliteView {
+public:
+    CachedBoardView(std::string&& cells, size_t width, size_t height)
+        : cells_(std::move(cells)), width_(width), height_(height) {}
+    char getObjectAt(size_t x, size_t y) const override {
+        return (y < height_ && x < width_) ? cells_[y * width_ + x] : ' ';
+    }
+private:
+    std::string cells_;   // row-major, width_ * height_
+    size_t width_, height_;
+};
+
+// "<name> <value>" on its own line
+template <typename T>
+bool readField(std::istream& in, const char* name, T& value) {
+    std::string line, tag;
+    if (!std::getline(in, line)) return false;
+    std::istringstream ss(line);
+    return (ss >> tag >> value) && tag == name && (ss >> std::ws).eof();
+}
+
+bool readBoard(std::istream& in, std::size_t rows, std::size_t cols, std::string& cells) {
+    std::string line, tag;
+    std::size_t r = 0, c = 0;
+    if (!std::getline(in, line)) return false;
+    std::istringstream ss(line);
+    if (!(ss >> tag >> r >> c) || tag != "board" || r != rows || c != cols) return false;
+    cells.reserve(rows * cols);
+    for (std::size_t y = 0; y < rows; ++y) {
+        if (!std::getline(in, line) || line.size() != cols) return false;
+        cells += line;
+    }
+    return true;
+}
+
+} // namespace
+
+std::string ResultCacheKey::text() const {
+    return "gm=" + hex(gameManager) + " map=" + hex(map) + " a1=" + hex(algo1) + " a2=" + hex(algo2) +
+           " limits=" + std::to_string(decisionMs) + "/" + std::to_string(gameMs);
+}
+
+ResultCache::ResultCache(std::string dir) : dir_(std::move(dir)) {}
+
+bool ResultCache::hashFile(const std::string& path, std::uint64_t& out) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    out = MapCache::hashSource(file.view());
+    return true;
+}
+
+std::string ResultCache::pathFor(const ResultCacheKey& key) const {
+    return (fs::path(dir_) / (hex(MapCache::hashSource(key.text())) + ".grc")).string();
+}
+
+bool ResultCache::lookup(const ResultCacheKey& key, std::size_t rows, std::size_t cols, GameResult& out) const {
+    std::ifstream in(pathFor(key));
+    std::string line;
+    if (!std::getline(in, line) || line != kHeader) return false;
+    if (!std::getline(in, line) || line != "key " + key.text()) return false;
+
+    int winner = 0, reason = 0;
+    std::size_t rounds = 0, p1 = 0, p2 = 0;
+    if (!readField(in, "winner", winner) || !readField(in, "reason", reason) ||
+        !readField(in, "rounds", rounds) || winner < 0 || winner > 2 ||
+        reason < GameResult::ALL_TANKS_DEAD || reason > GameResult::ZERO_SHELLS) {
+        return false;
+    }
+    if (!std::getline(in, line)) return false;
+    std::istringstream remaining(line);
+    std::string tag;
+    if (!(remaining >> tag >> p1 >> p2) || tag != "remaining") return false;
+
+    std::string cells;
+    if (!readBoard(in, rows, cols, cells)) return false;
+
+    out.winner = winner;
+    out.reason = static_cast<GameResult::Reason>(reason);
+    out.rounds = rounds;
+    out.remaining_tanks = {p1, p2};
+    out.gameState = std::make_unique<CachedBoardView>(std::move(cells), cols, rows);
+    return true;
+}
+
+bool ResultCache::store(const ResultCacheKey& key, const GameResult& gr, std::size_t rows, std::size_t cols) const {
+    std::string text = std::string(kHeader) + "\nkey " + key.text() +
+                       "\nwinner " + std::to_string(gr.winner) +
+                       "\nreason " + std::to_string(static_cast<int>(gr.reason)) +
+                       "\nrounds " + std::to_string(gr.rounds) +
+                       "\nremaining " + std::to_string(gr.remaining_tanks.size() > 0 ? gr.remaining_tanks[0] : 0) +
+                       " " + std::to_string(gr.remaining_tanks.size() > 1 ? gr.remaining_tanks[1] : 0) +
+                       "\nboard " + std::to_string(rows) + " " + std::to_string(cols) + "\n";
+    text.reserve(text.size() + rows * (cols + 1));
+    for (std::size_t y = 0; y < rows; ++y) {
+        for (std::size_t x = 0; x < cols; ++x) {
+            const char c = gr.gameState ? gr.gameState->getObjectAt(x, y) : ' ';
+            text += (c == '\n' || c == '\r') ? ' ' : c;
+        }
+        text += '\n';
+    }
+
+    return writeFileAtomically(pathFor(key), text);
+}
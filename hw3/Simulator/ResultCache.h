@@ -0,0 +1,54 @@
+// Simulator/ResultCache.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "GameResult.h"
+
+/// Everything that decides how a game ends, by content hash. File names are
+/// not part of it, so renamed or moved maps and plugins still hit.
+struct ResultCacheKey {
+    std::uint64_t gameManager = 0, map = 0, algo1 = 0, algo2 = 0;
+    std::uint64_t decisionMs = 0, gameMs = 0;   // time budgets in force
+
+    /// Canonical text form; stored in the entry so a hash collision is a miss.
+    std::string text() const;
+};
+
+/// Finished games on disk (result_cache=<dir>), one small text file per
+/// game named after the hash of its key (<16 hex digits>.grc):
+///     # game result cache v1
+///     key <ResultCacheKey::text()>
+///     winner <n>
+///     reason <n>
+///     rounds <n>
+///     remaining <p1> <p2>
+///     board <rows> <cols>
+///     <rows lines of cols cells>
+/// Entries are written to a temporary name and renamed into place, like the
+/// map cache. Anything that does not parse, or whose key or board size does
+/// not match, is a miss. Only meaningful for deterministic algorithms.
+class ResultCache {
+public:
+    explicit ResultCache(std::string dir);
+
+    const std::string& dir() const { return dir_; }
+
+    /// FNV-1a over the file's bytes; false if it cannot be read. Games
+    /// involving such a file must bypass the cache: its key would be
+    /// shared with every other unreadable file.
+    static bool hashFile(const std::string& path, std::uint64_t& out);
+
+    /// Fill `out` (final board included) from the entry for `key`.
+    bool lookup(const ResultCacheKey& key, std::size_t rows, std::size_t cols, GameResult& out) const;
+
+    /// A null final board is stored as a board of spaces.
+    bool store(const ResultCacheKey& key, const GameResult& gr, std::size_t rows, std::size_t cols) const;
+
+private:
+    std::string pathFor(const ResultCacheKey& key) const;
+
+    std::string dir_;
+};
@@ -4,6 +4,7 @@
 #include "SatelliteView.h"
 #include "GameResult.h"
 #include "ErrorLogger.h"
+#include "GridClassifier.h"
 
 #include <set>
 #include <iostream>
@@ -16,6 +17,8 @@
 #include <thread>
 #include <dlfcn.h>
 #include <stdexcept>
+#include <cstdio>
+#include <cstring>
 
 using namespace UserCommon_315634022;
 namespace fs = std::filesystem;
@@ -31,13 +34,71 @@ ComparativeEntry::ComparativeEntry(std::string g, GameResult r, std::string fs)
 CompetitionEntry::CompetitionEntry(std::string m, std::string x, std::string y, GameResult r)
     : mapFile(std::move(m)), a1(std::move(x)), a2(std::move(y)), res(std::move(r)) {}
 
+void CompetitionTally::record(const std::string& a1, const std::string& a2, int winner) {
+    ++games;
+    auto& t1 = algorithms[a1];
+    auto& t2 = algorithms[a2];
+    if (winner == 1) {
+        t1.score += 3; ++t1.wins; ++t2.losses;
+    } else if (winner == 2) {
+        t2.score += 3; ++t2.wins; ++t1.losses;
+    } else {
+        t1.score += 1; ++t1.ties;
+        t2.score += 1; ++t2.ties;
+    }
+}
+
+void CompetitionTally::recordProfile(const std::string& mapName, const std::string& a1,
+                                     const std::string& a2, const GameProfile& profile) {
+    ++profiledGames;
+    profilePerMap[mapName].add(profile, -1);
+    profilePerAlgo[a1].add(profile, 0);
+    profilePerAlgo[a2].add(profile, 1);
+}
+
+void ProfileTotals::add(const GameProfile& p, int side) {
+    ++games;
+    turns += p.turns;
+    for (size_t i = 0; i < GameProfile::kPhaseCount; ++i) phaseCycles[i] += p.phaseCycles[i];
+    for (int s = 0; s < 2; ++s) {
+        if (side != -1 && side != s) continue;
+        algoCycles += p.algoCycles[s];
+        algoCalls  += p.algoCalls[s];
+    }
+}
+
 // Constructor
 Simulator::Simulator(const Config& config) 
     : config_(config) {
     logInfo("SIMULATOR", "constructor", "Initializing Simulator in " + 
-        std::string(config_.modeComparative ? "comparative" : "competition") + " mode");
+        std::string(config_.modeComparative ? "comparative" : config_.modeMerge ? "merge" : "competition") + " mode");
     
     threadPool_ = std::make_unique<ThreadPool>(config_.numThreads);
+    if (!config_.map_cache.empty()) {
+        std::error_code ec;
+        fs::create_directories(config_.map_cache, ec);
+        if (ec || !fs::is_directory(config_.map_cache)) {
+            logWarn("SIMULATOR", "constructor", "Cannot use map_cache directory '" + config_.map_cache + "', map cache disabled");
+        } else {
+            mapCache_ = std::make_unique<MapCache>(config_.map_cache);
+            logInfo("SIMULATOR", "constructor", "Using map cache in " + config_.map_cache);
+        }
+    }
+    if (config_.modeCompetition && !config_.result_cache.empty()) {
+        std::error_code ec;
+        fs::create_directories(config_.result_cache, ec);
+        if (ec || !fs::is_directory(config_.result_cache)) {
+            logWarn("SIMULATOR", "constructor", "Cannot use result_cache directory '" + config_.result_cache + "', result cache disabled");
+        } else {
+            resultCache_ = std::make_unique<ResultCache>(config_.result_cache);
+            logInfo("SIMULATOR", "constructor", "Using result cache in " + config_.result_cache);
+        }
+    }
+    if (config_.modeCompetition && (config_.scheduler == "cost" || !config_.schedule_history.empty())) {
+        costScheduler_ = std::make_unique<CostScheduler>(config_.schedule_history);
+        logInfo("SIMULATOR", "constructor", "Game scheduler: " + config_.scheduler +
+                (config_.schedule_history.empty() ? "" : ", history " + config_.schedule_history));
+    }
     logInfo("SIMULATOR", "constructor", "Created ThreadPool with " + 
         std::to_string(config_.numThreads) + " threads");
 }
@@ -53,7 +114,9 @@ Simulator::~Simulator() {
 int Simulator::run() {
     logInfo("SIMULATOR", "run", "Starting simulation execution");
     
-    int result = config_.modeComparative ? runComparative() : runCompetition();
+    int result = config_.modeComparative ? runComparative()
+               : config_.modeMerge       ? runMerge()
+                                         : runCompetition();
     
     logInfo("SIMULATOR", "run", "Simulation completed with exit code " + std::to_string(result));
     return result;
@@ -131,15 +194,42 @@ int Simulator::runCompetition() {
         return 1;
     }
     logInfo("SIMULATOR", "runCompetition", "Successfully loaded " + std::to_string(loadedAlgorithms_) + " algorithm(s)");
+    if (!openCompetitionJournal()) {
+        return 1;
+    }
+    if (resultCache_) hashCompetitionPlugins();
+    startMetricsReporter();
     dispatchCompetitionTasks();
-    writeCompetitionFile(competitionResults_);
-    logInfo("SIMULATOR", "runCompetition", "Competition Results Summary:");
-    for (const auto& e : competitionResults_) {
-        logInfo("RESULTS", "runCompetition", "Map=" + e.mapFile + " A1=" + e.a1 + " A2=" + e.a2 + " => winner=" + std::to_string(e.res.winner) + " reason=" + std::to_string(static_cast<int>(e.res.reason)) + " rounds=" + std::to_string(e.res.rounds));
+    stopMetricsReporter();
+    if (journal_) journal_->close();
+    if (config_.shardCount > 1) {
+        writeShardFile(competitionTally_);
+    } else {
+        writeCompetitionFile(competitionTally_);
     }
+    if (config_.profile) writeProfileFile(competitionTally_);
+    logCompetitionSummary();
     return 0;
 }
 
+void Simulator::logCompetitionSummary() const {
+    logInfo("SIMULATOR", "runCompetition", "Competition Results Summary (" +
+            std::to_string(competitionTally_.games) + " games, " + std::to_string(metrics_.resumed.load()) + " resumed, " + std::to_string(metrics_.cached.load()) + " cached):");
+    for (const auto& [name, t] : competitionTally_.algorithms) {
+        logInfo("RESULTS", "runCompetition", "A=" + name + " score=" + std::to_string(t.score) +
+                " wins=" + std::to_string(t.wins) + " losses=" + std::to_string(t.losses) +
+                " ties=" + std::to_string(t.ties));
+    }
+    for (const auto& e : competitionResults_) {
+        std::string line = "Map=" + e.mapFile + " A1=" + e.a1 + " A2=" + e.a2 + " final board:";
+        for (size_t y = 0; e.res.gameState && y < e.rows; ++y) {
+            line += "\n";
+            for (size_t x = 0; x < e.cols; ++x) line += e.res.gameState->getObjectAt(x, y);
+        }
+        logInfo("RESULTS", "runCompetition", line);
+    }
+}
+
 // Helper method to parse parameter lines with flexible spacing around '='
 bool Simulator::parseParameter(const std::string& line, const std::string& paramName, 
                               size_t& value, const std::string& path) const {
@@ -206,151 +296,132 @@ void Simulator::parseParameterValue(const std::string& afterEquals, const std::s
     }
 }
 
-// Character cleaning - only keep valid game objects, replace invalid with space
-char Simulator::cleanCharacter(char c) const {
-    switch (c) {
-        case '@':  // Mine
-        case '#':  // Wall  
-        case '1':  // Tank player 1
-        case '2':  // Tank player 2
-        case ' ':  // Empty space
-            return c;
-        default:
-            // Replace any other character (including '.') with space
-            return ' ';
-    }
+// Next line of a mapped map file starting at pos (getline semantics, one
+// trailing '\r' dropped); advances pos past the '\n'.
+static std::string_view nextMapLine(std::string_view text, size_t& pos) {
+    const char* begin = text.data() + pos;
+    const size_t left = text.size() - pos;
+    const void* nl = std::memchr(begin, '\n', left);
+    size_t len = nl ? static_cast<size_t>(static_cast<const char*>(nl) - begin) : left;
+    pos += nl ? len + 1 : len;
+    if (len > 0 && begin[len - 1] == '\r') --len;
+    return {begin, len};
 }
 
-// Enhanced grid normalization with character cleaning and flexible dimensions
-std::vector<std::string> Simulator::cleanAndNormalizeGrid(const std::vector<std::string>& rawGrid, 
-                                                          size_t targetRows, size_t targetCols, 
-                                                          const std::string& path) const {
-    std::vector<std::string> normalized;
-    normalized.reserve(targetRows);
-    std::set<char> invalidCharsFound;
-
-    processGridRows(rawGrid, normalized, targetRows, targetCols, invalidCharsFound);
-    logExtraRowsIgnored(rawGrid, targetRows);
-    logInvalidCharacters(invalidCharsFound, path);
-    
-    return normalized;
-}
+// Map loading: mmap the file, parse the header lines, then classify the grid
+// straight into its final rows*cols buffer in a single pass.
+MapData Simulator::loadMapWithParams(const std::string& path) const {
+    logDebug("MAPLOADER", "loadMapWithParams", "Loading map from: " + path);
 
-void Simulator::processGridRows(const std::vector<std::string>& rawGrid, 
-                               std::vector<std::string>& normalized,
-                               size_t targetRows, size_t targetCols, 
-                               std::set<char>& invalidCharsFound) const {
-    for (size_t row = 0; row < targetRows; ++row) {
-        std::string normalizedRow;
-        normalizedRow.reserve(targetCols);
-        
-        if (row < rawGrid.size()) {
-            processExistingRow(rawGrid[row], normalizedRow, targetCols, invalidCharsFound);
-        } else {
-            normalizedRow = std::string(targetCols, ' ');
+    MappedFile file = openMapFile(path);
+    const std::uint64_t hash = (mapCache_ || resultCache_) ? MapCache::hashSource(file.view()) : 0;
+    if (mapCache_) {
+        MapCache::Entry entry;
+        if (mapCache_->lookup(hash, file.size(), entry)) {
+            MapData md = buildCachedMapData(path, entry);
+            md.contentHash = hash;
+            return md;
         }
-        normalized.push_back(std::move(normalizedRow));
     }
-}
 
-void Simulator::processExistingRow(const std::string& sourceRow, std::string& normalizedRow,
-                                  size_t targetCols, std::set<char>& invalidCharsFound) const {
-    for (size_t col = 0; col < targetCols; ++col) {
-        if (col < sourceRow.size()) {
-            char originalChar = sourceRow[col];
-            char cleanedChar = cleanCharacter(originalChar);
-            
-            if (originalChar != cleanedChar) {
-                invalidCharsFound.insert(originalChar);
-            }
-            normalizedRow += cleanedChar;
-        } else {
-            normalizedRow += ' ';
-        }
-    }
-}
+    MapParameters params;
+    params.path = path;
+    const size_t gridStart = parseMapHeader(file.view(), params);
+    validateMapParameters(params, path);
 
-void Simulator::logExtraRowsIgnored(const std::vector<std::string>& rawGrid, size_t targetRows) const {
-    if (rawGrid.size() > targetRows) {
-        logDebug("MAPLOADER", "cleanAndNormalizeGrid", 
-            "Ignored " + std::to_string(rawGrid.size() - targetRows) + " extra rows");
+    MapGrid grid = scanGrid(file.view(), gridStart, params);
+    logGridWarnings(params, grid);
+    if (config_.debug) {
+        logNormalizedGrid(grid, params.cols);
     }
+    if (mapCache_ && !params.headerWarnings) {
+        storeCachedMap(hash, file.size(), params, grid);
+    }
+
+    MapData md = buildMapData(params, std::move(grid));
+    md.contentHash = hash;
+    return md;
 }
 
-void Simulator::logInvalidCharacters(const std::set<char>& invalidCharsFound, const std::string& path) const {
-    if (!invalidCharsFound.empty()) {
-        std::string invalidCharsStr = buildInvalidCharsString(invalidCharsFound);
-        std::string errorMsg = "Invalid characters found in " + path + 
-                              " (replaced with spaces): " + invalidCharsStr;
-        logWarn("MAPLOADER", "cleanAndNormalizeGrid", errorMsg);
+// Cache hit: no text processing; the same warnings are reported from the
+// recorded source shape, and the view reads straight from the mapping.
+MapData Simulator::buildCachedMapData(const std::string& path, MapCache::Entry& entry) const {
+    const MapCacheHeader& h = *entry.header;
+    MapParameters params;
+    params.path = path;
+    params.rows = h.rows;
+    params.cols = h.cols;
+    params.maxSteps = h.maxSteps;
+    params.numShells = h.numShells;
+
+    MapGrid shape;               // cells stay empty; only the source shape is needed
+    shape.fileRows = h.fileRows;
+    shape.maxFileCols = h.maxFileCols;
+    for (size_t b = 0; b < 256; ++b) {
+        if ((h.invalidChars[b / 64] >> (b % 64)) & 1u) shape.invalidChars.set(b);
     }
+    logGridWarnings(params, shape);
+
+    MapData md;
+    md.rows = params.rows;
+    md.cols = params.cols;
+    md.maxSteps = params.maxSteps;
+    md.numShells = params.numShells;
+    md.view = entry.takeView();
+    logDebug("MAPLOADER", "loadMapWithParams", "Map loaded from cache " + mapCache_->dir());
+    return md;
 }
 
-std::string Simulator::buildInvalidCharsString(const std::set<char>& invalidChars) const {
-    std::string result;
-    for (char c : invalidChars) {
-        if (!result.empty()) result += ", ";
-        result += (c == ' ') ? "' '" : "'" + std::string(1, c) + "'";
+void Simulator::storeCachedMap(std::uint64_t hash, size_t sourceSize,
+                               const MapParameters& params, const MapGrid& grid) const {
+    MapCacheHeader h = MapCache::makeHeader(hash, sourceSize);
+    h.rows = params.rows;
+    h.cols = params.cols;
+    h.maxSteps = params.maxSteps;
+    h.numShells = params.numShells;
+    h.fileRows = grid.fileRows;
+    h.maxFileCols = grid.maxFileCols;
+    for (size_t b = 0; b < 256; ++b) {
+        if (grid.invalidChars.test(b)) h.invalidChars[b / 64] |= std::uint64_t(1) << (b % 64);
     }
-    return result;
-}
-// Fixed Map loading with enhanced error handling and flexibility
-MapData Simulator::loadMapWithParams(const std::string& path) const {
-    logDebug("MAPLOADER", "loadMapWithParams", "Loading map from: " + path);
-    
-    std::ifstream in = openMapFile(path);
-    MapParameters params = parseMapParameters(in, path);
-    validateMapParameters(params, path);
-    
-    std::vector<std::string> normalizedGrid = createNormalizedGrid(params);
-    if (config_.debug) {
-        logNormalizedGrid(normalizedGrid);
+    if (!mapCache_->store(h, grid.cells)) {
+        logWarn("MAPLOADER", "loadMapWithParams", "Could not write map cache entry for " + params.path);
     }
-    
-    return buildMapData(params, std::move(normalizedGrid));
 }
 
-std::ifstream Simulator::openMapFile(const std::string& path) const {
-    std::ifstream in(path);
-    if (!in.is_open()) {
+MappedFile Simulator::openMapFile(const std::string& path) const {
+    MappedFile file;
+    if (!file.open(path)) {
         std::string errorMsg = "Failed to open map file: " + path;
         ErrorLogger::instance().log(errorMsg);
         throw std::runtime_error(errorMsg);
     }
-    return in;
+    return file;
 }
 
-MapParameters Simulator::parseMapParameters(std::ifstream& in, const std::string& path) const {
-    MapParameters params;
-    params.path = path; 
-    std::string line;
-    
+// Returns the offset of the first grid line (text.size() if there is none).
+size_t Simulator::parseMapHeader(std::string_view text, MapParameters& params) const {
+    size_t pos = 0;
     int lineNumber = 0;
-    
-    while (std::getline(in, line)) {
+
+    while (pos < text.size()) {
+        const size_t lineStart = pos;
+        const std::string line(nextMapLine(text, pos));
         lineNumber++;
-        cleanLine(line);
-        
+
         if (lineNumber == 1) {
             logDebug("MAPLOADER", "loadMapWithParams", "Map name/description: " + line);
             continue;
         }
-        
-        if (!processMapLine(line, params, lineNumber, path)) {
-            break; // Start processing grid data
+
+        if (!processMapLine(line, params, lineNumber, params.path)) {
+            return lineStart; // this line is the first grid row
         }
     }
-    
-    // Continue reading grid data
-    while (std::getline(in, line)) {
-        cleanLine(line);
-        params.rawGridLines.push_back(line);
-    }
-    
-    return params;
+    return text.size();
 }
 
-bool Simulator::processMapLine(const std::string& line, MapParameters& params, 
+bool Simulator::processMapLine(const std::string& line, MapParameters& params,
                               int lineNumber, const std::string& path) const {
     if (tryParseParameter(line, "Rows", params.rows, params.foundRows, path) ||
         tryParseParameter(line, "Cols", params.cols, params.foundCols, path) ||
@@ -358,19 +429,19 @@ bool Simulator::processMapLine(const std::string& line, MapParameters& params,
         tryParseParameter(line, "NumShells", params.numShells, params.foundNumShells, path)) {
         return true;
     }
-    
+
     // Check if all headers found or past expected header lines
-    bool headersParsed = params.foundRows && params.foundCols && 
+    bool headersParsed = params.foundRows && params.foundCols &&
                         params.foundMaxSteps && params.foundNumShells;
-    
+
     if (headersParsed || lineNumber > 5 || !looksLikeParameter(line)) {
-        params.rawGridLines.push_back(line);
         return false; // Start grid processing
     }
-    
+
     if (!line.empty()) {
-        logWarn("MAPLOADER", "loadMapWithParams", 
+        logWarn("MAPLOADER", "loadMapWithParams",
                "Ignoring extra metadata line in " + path + ": " + line);
+        params.headerWarnings = true;
     }
     return true;
 }
@@ -380,7 +451,7 @@ bool Simulator::tryParseParameter(const std::string& line, const std::string& pa
     if (line.find(paramName) != std::string::npos && line.find("=") != std::string::npos) {
         if (parseParameter(line, paramName, value, path)) {
             found = true;
-            logDebug("MAPLOADER", "loadMapWithParams", 
+            logDebug("MAPLOADER", "loadMapWithParams",
                     "Parsed " + paramName + " = " + std::to_string(value));
         }
         return true;
@@ -399,7 +470,6 @@ bool Simulator::looksLikeParameter(const std::string& line) const {
 void Simulator::validateMapParameters(const MapParameters& params, const std::string& path) const {
     checkRequiredHeaders(params, path);
     validateDimensions(params, path);
-    checkDimensionMismatches(params, path);
 }
 
 void Simulator::checkRequiredHeaders(const MapParameters& params, const std::string& path) const {
@@ -408,7 +478,7 @@ void Simulator::checkRequiredHeaders(const MapParameters& params, const std::str
     if (!params.foundCols) missingHeaders.push_back("Cols");
     if (!params.foundMaxSteps) missingHeaders.push_back("MaxSteps");
     if (!params.foundNumShells) missingHeaders.push_back("NumShells");
-    
+
     if (!missingHeaders.empty()) {
         std::string errorMsg = "Missing required headers in " + path + ": ";
         for (size_t i = 0; i < missingHeaders.size(); ++i) {
@@ -420,33 +490,79 @@ void Simulator::checkRequiredHeaders(const MapParameters& params, const std::str
     }
 }
 
-std::vector<std::string> Simulator::createNormalizedGrid(const MapParameters& params) const {
-    logDebug("MAPLOADER", "loadMapWithParams", 
-            "Parsed map parameters - rows=" + std::to_string(params.rows) + 
-            ", cols=" + std::to_string(params.cols) + 
-            ", maxSteps=" + std::to_string(params.maxSteps) + 
+// One pass over the grid lines: rows beyond Rows and columns beyond Cols are
+// only measured, missing ones stay ' ', everything else is classified in place.
+MapGrid Simulator::scanGrid(std::string_view text, size_t pos, const MapParameters& params) const {
+    MapGrid grid;
+    grid.cells.assign(params.rows * params.cols, ' ');
+
+    while (pos < text.size()) {
+        const std::string_view line = nextMapLine(text, pos);
+        const size_t row = grid.fileRows++;
+        grid.maxFileCols = std::max(grid.maxFileCols, line.size());
+        if (row >= params.rows) continue;
+
+        const size_t n = std::min(line.size(), params.cols);
+        if (cleanGridBytes(line.data(), n, &grid.cells[row * params.cols])) {
+            noteInvalidBytes(line.data(), n, grid.invalidChars);
+        }
+    }
+    return grid;
+}
+
+void Simulator::logGridWarnings(const MapParameters& params, const MapGrid& grid) const {
+    logDebug("MAPLOADER", "loadMapWithParams",
+            "Parsed map parameters - rows=" + std::to_string(params.rows) +
+            ", cols=" + std::to_string(params.cols) +
+            ", maxSteps=" + std::to_string(params.maxSteps) +
             ", numShells=" + std::to_string(params.numShells));
+    checkDimensionMismatches(params, grid, params.path);
+    logExtraRowsIgnored(grid, params.rows);
+
+    std::set<char> invalidCharsFound;
+    for (size_t b = 0; b < grid.invalidChars.size(); ++b) {
+        if (grid.invalidChars.test(b)) invalidCharsFound.insert(static_cast<char>(b));
+    }
+    logInvalidCharacters(invalidCharsFound, params.path);
+}
 
-    return cleanAndNormalizeGrid(params.rawGridLines, params.rows, params.cols, params.path);
+void Simulator::logExtraRowsIgnored(const MapGrid& grid, size_t targetRows) const {
+    if (grid.fileRows > targetRows) {
+        logDebug("MAPLOADER", "cleanAndNormalizeGrid",
+            "Ignored " + std::to_string(grid.fileRows - targetRows) + " extra rows");
+    }
+}
+
+void Simulator::logInvalidCharacters(const std::set<char>& invalidCharsFound, const std::string& path) const {
+    if (!invalidCharsFound.empty()) {
+        std::string invalidCharsStr = buildInvalidCharsString(invalidCharsFound);
+        std::string errorMsg = "Invalid characters found in " + path +
+                              " (replaced with spaces): " + invalidCharsStr;
+        logWarn("MAPLOADER", "cleanAndNormalizeGrid", errorMsg);
+    }
+}
 
-    // return cleanAndNormalizeGrid(params.rawGridLines, params.rows, params.cols, "");
+std::string Simulator::buildInvalidCharsString(const std::set<char>& invalidChars) const {
+    std::string result;
+    for (char c : invalidChars) {
+        if (!result.empty()) result += ", ";
+        result += (c == ' ') ? "' '" : "'" + std::string(1, c) + "'";
+    }
+    return result;
 }
 
-MapData Simulator::buildMapData(const MapParameters& params, 
-                               std::vector<std::string>&& normalizedGrid) const {
+MapData Simulator::buildMapData(const MapParameters& params, MapGrid&& grid) const {
     class MapView : public SatelliteView {
     public:
-        MapView(std::vector<std::string>&& rows)
-            : rows_(std::move(rows)),
-              width_(rows_.empty() ? 0 : rows_[0].size()),
-              height_(rows_.size()) {}
+        MapView(std::string&& cells, size_t width, size_t height)
+            : cells_(std::move(cells)), width_(width), height_(height) {}
         char getObjectAt(size_t x, size_t y) const override {
-            return (y < height_ && x < width_) ? rows_[y][x] : ' ';
+            return (y < height_ && x < width_) ? cells_[y * width_ + x] : ' ';
         }
         size_t width() const { return width_; }
         size_t height() const { return height_; }
     private:
-        std::vector<std::string> rows_;
+        std::string cells_;   // row-major, width_ * height_
         size_t width_, height_;
     };
 
@@ -455,84 +571,53 @@ MapData Simulator::buildMapData(const MapParameters& params,
     md.cols = params.cols;
     md.maxSteps = params.maxSteps;
     md.numShells = params.numShells;
-    md.view = std::make_unique<MapView>(std::move(normalizedGrid));
-    
+    md.view = std::make_unique<MapView>(std::move(grid.cells), params.cols, params.rows);
+
     logDebug("MAPLOADER", "loadMapWithParams", "Map loaded successfully");
     return md;
 }
 
-// Missing helper function implementations
-
-void Simulator::cleanLine(std::string& line) const {
-    // Remove carriage return if present
-    if (!line.empty() && line.back() == '\r') {
-        line.pop_back();
-    }
-}
-
 void Simulator::validateDimensions(const MapParameters& params, const std::string& path) const {
     if (params.rows == 0 || params.cols == 0) {
-        std::string errorMsg = "Invalid dimensions in " + path + 
-                              ": rows=" + std::to_string(params.rows) + 
+        std::string errorMsg = "Invalid dimensions in " + path +
+                              ": rows=" + std::to_string(params.rows) +
                               ", cols=" + std::to_string(params.cols);
         ErrorLogger::instance().log(errorMsg);
         throw std::runtime_error(errorMsg);
     }
 }
 
-void Simulator::checkDimensionMismatches(const MapParameters& params, const std::string& path) const {
+void Simulator::checkDimensionMismatches(const MapParameters& params, const MapGrid& grid,
+                                         const std::string& path) const {
     // Check row dimension mismatches
-    if (params.rawGridLines.size() != params.rows) {
-        std::string errorMsg = "Map dimension mismatch in " + path + 
-                              ": expected " + std::to_string(params.rows) + 
-                              " rows, found " + std::to_string(params.rawGridLines.size()) + 
+    if (grid.fileRows != params.rows) {
+        std::string errorMsg = "Map dimension mismatch in " + path +
+                              ": expected " + std::to_string(params.rows) +
+                              " rows, found " + std::to_string(grid.fileRows) +
                               " (will be adjusted automatically)";
         logWarn("MAPLOADER", "loadMapWithParams", errorMsg);
     }
-    
+
     // Check column dimension mismatches
-    size_t maxColsFound = 0;
-    for (const auto& line : params.rawGridLines) {
-        maxColsFound = std::max(maxColsFound, line.size());
-    }
-    
-    if (maxColsFound != params.cols) {
-        std::string errorMsg = "Map dimension mismatch in " + path + 
-                              ": expected " + std::to_string(params.cols) + 
-                              " cols, found max " + std::to_string(maxColsFound) + 
+    if (grid.maxFileCols != params.cols) {
+        std::string errorMsg = "Map dimension mismatch in " + path +
+                              ": expected " + std::to_string(params.cols) +
+                              " cols, found max " + std::to_string(grid.maxFileCols) +
                               " (will be adjusted automatically)";
         logWarn("MAPLOADER", "loadMapWithParams", errorMsg);
     }
 }
 
-void Simulator::logNormalizedGrid(const std::vector<std::string>& normalizedGrid) const {
+void Simulator::logNormalizedGrid(const MapGrid& grid, size_t cols) const {
     logDebug("MAPLOADER", "loadMapWithParams", "Normalized grid:");
-    for (size_t r = 0; r < normalizedGrid.size(); ++r) {
+    const size_t rows = cols ? grid.cells.size() / cols : 0;
+    for (size_t r = 0; r < rows; ++r) {
         std::string debugStr = "Row " + std::to_string(r) + ": '";
-        for (char c : normalizedGrid[r]) {
-            debugStr += (c == ' ') ? ' ' : c;  // Show spaces as underscores for clarity
-        }
+        debugStr.append(grid.cells, r * cols, cols);
         debugStr += "'";
         logDebug("MAPLOADER", "loadMapWithParams", debugStr);
     }
 }
-
-// Character normalization - only keep valid game objects
-char Simulator::normalizeCell(char c) const {
-    switch (c) {
-        case '@':  // Mine
-        case '#':  // Wall  
-        case '1':  // Tank player 1
-        case '2':  // Tank player 2
-            logDebug("MAPLOADER", "normalizeCell", "Keeping character: '" + std::string(1, c) + "'");
-            return c;
-        default:
-            if (config_.debug && c != '.' && c != ' ') {
-                logDebug("MAPLOADER", "normalizeCell", "Converting '" + std::string(1, c) + "' to space");
-            }
-            return ' ';  // Empty cell (includes original '.' and any other chars)
-    }
-}
 // Algorithm plugin loading - WITH TIMING PRESERVATION
 bool Simulator::loadAlgorithmPlugins() {
     // Add small delay to preserve timing that prevents segfault
@@ -778,6 +863,8 @@ bool Simulator::validateGameManagerRegistration(GameManagerRegistrar& gmReg, voi
 void Simulator::finalizeGameManagerLoad(void* handle, const std::string& path, const std::string& name) {
     logDebug("PLUGINLOADER", "loadGameManagerPlugins", 
             "GameManager '" + name + "' loaded and validated successfully");
+    applyGameLimits(handle);
+    applyReplayOutput(handle);
     gameManagerHandles_.push_back(handle);
     validGameManagerPaths_.push_back(path);
     loadedGameManagers_++;
@@ -810,6 +897,9 @@ bool Simulator::loadSingleGameManager() {
 
     logDebug("PLUGINLOADER", "loadSingleGameManager", 
         "GameManager '" + gmName + "' loaded and validated successfully");
+    if (config_.profile) enableGameManagerProfiling(gmH);
+    applyGameLimits(gmH);
+    applyReplayOutput(gmH);
     gameManagerHandles_.push_back(gmH);
     loadedGameManagers_ = 1;
     return true;
@@ -863,6 +953,10 @@ void Simulator::executeComparativeGame(const auto& gmEntry, const auto& A, const
     const std::string gmName = stripSoExtension(validGameManagerPaths_[gi]);
     try {
         GameResult gr = runComparativeGame(gmEntry, A, B, md, realMap, mapFile, algo1Name, algo2Name);
+        const std::string timeout = fetchGameTimeout(gi);
+        if (!timeout.empty()) {
+            logWarn("WATCHDOG", "executeComparativeGame", "GM=" + gmName + " Map=" + mapFile + " A1=" + algo1Name + " A2=" + algo2Name + ": " + timeout);
+        }
         std::string finalMap = buildFinalMapString(gr, md);
         
         std::lock_guard<std::mutex> lock(resultsMutex_);
@@ -913,91 +1007,521 @@ std::string Simulator::buildFinalMapString(const GameResult& gr, const MapData&
 }
 
 void Simulator::dispatchCompetitionTasks() {
-    CompetitionSetup setup = prepareCompetitionData();
-    if (setup.mapViews.empty()) return;
+    CompetitionSetup setup;
+    prepareCompetitionData(setup);
+    if (setup.maps.empty()) return;
 
+    setup.deferGames = config_.scheduler == "cost" || config_.isolation == "process";
     enqueueCompetitionTasks(setup);
     finalizeTaskExecution();
+    competitionFingerprint_ = competitionFingerprint(setup);
+
+    logInfo("SIMULATOR", "preloadMapsAndTrackValid", "Successfully preloaded " + std::to_string(setup.validMaps) + " valid map(s)");
+    if (setup.validMaps == 0) {
+        logError("SIMULATOR", "dispatchCompetitionTasks", "No valid maps to run");
+        ErrorLogger::instance().log("No valid maps to run");
+        return;
+    }
+    if (setup.deferGames) runDeferredGames(setup);
+    if (costScheduler_) saveScheduleHistory();
 }
 
-CompetitionSetup Simulator::prepareCompetitionData() {
-    CompetitionSetup setup;
-    
-    // Collect all map files
+void Simulator::prepareCompetitionData(CompetitionSetup& setup) {
+    // Collect all map files; directory order decides each valid map's index
+    std::vector<std::string> files;
     for (auto& e : fs::directory_iterator(config_.game_maps_folder)) {
         if (e.is_regular_file()) {
-            setup.allMapFiles.push_back(e.path().string());
+            files.push_back(e.path().string());
         }
     }
-
-    // Preload valid maps
-    setup.mapViews = preloadMapsAndTrackValid(setup.allMapFiles, setup.validMapFiles, 
-                                             setup.mapRows, setup.mapCols, 
-                                             setup.mapMaxSteps, setup.mapNumShells);
-
-    if (setup.mapViews.empty()) {
-        logError("SIMULATOR", "dispatchCompetitionTasks", "No valid maps to run");
-        ErrorLogger::instance().log("No valid maps to run");
+    setup.maps.resize(files.size());
+    for (size_t fi = 0; fi < files.size(); ++fi) {
+        setup.maps[fi].file = std::move(files[fi]);
+        setup.maps[fi].slot = fi;
     }
-
-    return setup;
 }
 
-void Simulator::enqueueCompetitionTasks(const CompetitionSetup& setup) {
-    size_t totalGames = calculateTotalGames(setup.mapViews.size());
+// Each map file is parsed by its own pool task; games for a map are enqueued
+// as soon as it and every map before it have finished loading.
+void Simulator::enqueueCompetitionTasks(CompetitionSetup& setup) {
     logInfo("THREADPOOL", "dispatchCompetitionTasks", 
-           "Starting execution of " + std::to_string(totalGames) + " total games with " + 
+           "Loading " + std::to_string(setup.maps.size()) + " map file(s) and starting games with " + 
            std::to_string(config_.numThreads) + " threads");
 
     auto& gmReg = GameManagerRegistrar::get();
     auto& algoReg = AlgorithmRegistrar::get();
     auto& gmEntry = *gmReg.begin();
 
-    for (size_t mi = 0; mi < setup.mapViews.size(); ++mi) {
-        enqueueMapTasks(setup, mi, gmEntry, algoReg);
+    for (size_t fi = 0; fi < setup.maps.size(); ++fi) {
+        threadPool_->enqueue([this, &setup, fi, &gmEntry, &algoReg] {
+            loadCompetitionMap(setup, fi, gmEntry, algoReg);
+        });
     }
 }
 
-void Simulator::enqueueMapTasks(const CompetitionSetup& setup, size_t mi, 
+void Simulator::loadCompetitionMap(CompetitionSetup& setup, size_t fi,
+                                   const auto& gmEntry, AlgorithmRegistrar& algoReg) {
+    LoadedMap& slot = setup.maps[fi];
+    try {
+        MapData md = loadMapWithParams(slot.file);
+        slot.view = std::move(md.view);
+        slot.rows = md.rows;
+        slot.cols = md.cols;
+        slot.maxSteps = md.maxSteps;
+        slot.numShells = md.numShells;
+        slot.contentHash = md.contentHash;
+        if (setup.deferGames) slot.tanks = countTanks(*slot.view, slot.rows, slot.cols);
+        logDebug("MAPLOADER", "preloadMapsAndTrackValid", "Successfully preloaded map: " + slot.file);
+    } catch (const std::exception& ex) {
+        std::string warnMsg = "Skipping invalid map '" + slot.file + "': " + std::string(ex.what());
+        logWarn("MAPLOADER", "preloadMapsAndTrackValid", warnMsg);
+    } catch (...) {
+        logWarn("MAPLOADER", "preloadMapsAndTrackValid", "Skipping invalid map '" + slot.file + "': unknown error");
+    }
+    advanceMapFrontier(setup, fi, gmEntry, algoReg);   // always, or later maps would never be released
+}
+
+// The lock only covers the frontier bookkeeping. Claiming the released
+// maps' games (journal and result cache lookups) runs after it is dropped,
+// so other loader tasks never wait on that I/O.
+void Simulator::advanceMapFrontier(CompetitionSetup& setup, size_t fi,
+                                   const auto& gmEntry, AlgorithmRegistrar& algoReg) {
+    std::vector<std::pair<size_t, size_t>> released;   // (slot, valid-map index)
+    {
+        std::lock_guard<std::mutex> lock(setup.mutex);
+        setup.maps[fi].loaded = true;
+        while (setup.frontier < setup.maps.size() && setup.maps[setup.frontier].loaded) {
+            const LoadedMap& map = setup.maps[setup.frontier++];
+            if (!map.view) continue;
+            setup.mapOrder += fs::path(map.file).filename().string() + '\n';
+            (setup.deferGames ? setup.released : released).emplace_back(setup.frontier - 1, setup.validMaps++);
+        }
+        if (setup.deferGames) return;
+    }
+    for (const auto& [slot, mi] : released) enqueueMapTasks(setup.maps[slot], mi, gmEntry, algoReg);
+
+    std::lock_guard<std::mutex> lock(setup.mutex);
+    setup.queuedMaps += released.size();
+    if (setup.frontier == setup.maps.size() && setup.queuedMaps == setup.validMaps) metrics_.allQueued = true;
+}
+
+void Simulator::enqueueMapTasks(const LoadedMap& map, size_t mi, 
                                const auto& gmEntry, AlgorithmRegistrar& algoReg) {
-    SatelliteView& realMap = *setup.mapViews[mi];
-    size_t cols = setup.mapCols[mi], rows = setup.mapRows[mi];
-    size_t mSteps = setup.mapMaxSteps[mi], nShells = setup.mapNumShells[mi];
-    const std::string mapFile = setup.validMapFiles[mi];
+    for (const auto& [i, j] : competitionPairings(mi)) {
+        if (claimCompetitionGame(map, i, j)) enqueueCompetitionGame(map, i, j, gmEntry, algoReg);
+    }
+
+        // for (size_t j = i + 1; j < loadedAlgorithms_; ++j) {
+        //     threadPool_->enqueue([this, &algoReg, &gmEntry, &realMap, cols, rows, mSteps, nShells, mapFile, i, j] {
+        //         executeCompetitionGame(algoReg, gmEntry, realMap, cols, rows, mSteps, nShells, mapFile, i, j);
+        //     });
+        // }
+    }
 
+// Algorithm pairs (i, j) that play on the mi-th valid map
+std::vector<std::pair<size_t, size_t>> Simulator::competitionPairings(size_t mi) const {
+    std::vector<std::pair<size_t, size_t>> pairs;
     for (size_t i = 0; i < loadedAlgorithms_; ++i) {
         size_t j = (i+1 + (mi % (loadedAlgorithms_ - 1 ))) % loadedAlgorithms_;
         if ( loadedAlgorithms_ % 2 == 0 && mi == loadedAlgorithms_/2 - 1 && i >= loadedAlgorithms_/2) {
             continue;
         }
-         threadPool_->enqueue([this, &algoReg, &gmEntry, &realMap, cols, rows, mSteps, nShells, mapFile, i, j] {
-                executeCompetitionGame(algoReg, gmEntry, realMap, cols, rows, mSteps, nShells, mapFile, i, j);
-            });
+        pairs.emplace_back(i, j);
+    }
+    return pairs;
+}
+
+// Whether this process plays the game: it must belong to our shard and not
+// already be finished in the resume journal or the result cache
+bool Simulator::claimCompetitionGame(const LoadedMap& map, size_t i, size_t j) {
+    return inShard(map.file, i, j) && !resumeCompetitionGame(map, i, j) && !cachedCompetitionGame(map, i, j);
+}
+
+// Fold a game finished by an earlier run into the tally instead of playing it
+bool Simulator::resumeCompetitionGame(const LoadedMap& map, size_t i, size_t j) {
+    if (!journal_) return false;
+    const std::string algo1Name = stripSoExtension(validAlgorithmPaths_[i]);
+    const std::string algo2Name = stripSoExtension(validAlgorithmPaths_[j]);
+    const JournalKey key = journalKey(map.file, algo1Name, algo2Name);
+    const JournalEntry* e = journal_->find(key);
+    if (!e) return false;
+    if (!config_.journal.empty() && config_.journal != config_.resume) journal_->append(key, *e);   // new journal stays complete
+
+    logInfo("RESULTS", "runCompetition", "Map=" + map.file + " A1=" + algo1Name + " A2=" + algo2Name + " => winner=" + std::to_string(e->winner) + " reason=" + std::to_string(e->reason) + " rounds=" + std::to_string(e->rounds) + " (resumed)");
+    std::lock_guard<std::mutex> lock(resultsMutex_);
+    competitionTally_.record(algo1Name, algo2Name, e->winner);
+    metrics_.resumed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Fold a game some earlier run played with identical map and plugins
+bool Simulator::cachedCompetitionGame(const LoadedMap& map, size_t i, size_t j) {
+    if (!resultCacheable(i, j)) return false;
+    GameResult gr{};
+    if (!resultCache_->lookup(resultCacheKey(map.contentHash, i, j), map.rows, map.cols, gr)) return false;
+    const std::string algo1Name = stripSoExtension(validAlgorithmPaths_[i]);
+    const std::string algo2Name = stripSoExtension(validAlgorithmPaths_[j]);
+
+    logInfo("RESULTS", "runCompetition", "Map=" + map.file + " A1=" + algo1Name + " A2=" + algo2Name + " => winner=" + std::to_string(gr.winner) + " reason=" + std::to_string(static_cast<int>(gr.reason)) + " rounds=" + std::to_string(gr.rounds) + " (cached)");
+    tallyCompetitionResult(map.file, algo1Name, algo2Name, std::move(gr), nullptr, map.rows, map.cols);
+    metrics_.cached.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void Simulator::enqueueCompetitionGame(const LoadedMap& map, size_t i, size_t j,
+                                       const auto& gmEntry, AlgorithmRegistrar& algoReg) {
+    metrics_.queued.fetch_add(1, std::memory_order_relaxed);
+    if (processPool_) {
+        threadPool_->enqueue([this, &map, i, j] { executeIsolatedGame(map, i, j); });
+        return;
+    }
+    SatelliteView& realMap = *map.view;
+    size_t cols = map.cols, rows = map.rows;
+    size_t mSteps = map.maxSteps, nShells = map.numShells;
+    const std::string mapFile = map.file;
+    const std::uint64_t mapHash = map.contentHash;
+    threadPool_->enqueue([this, &algoReg, &gmEntry, &realMap, cols, rows, mSteps, nShells, mapFile, mapHash, i, j] {
+        executeCompetitionGame(algoReg, gmEntry, realMap, cols, rows, mSteps, nShells, mapFile, mapHash, i, j);
+    });
+}
+
+// Games held back until every map was loaded (scheduler=cost, isolation=process)
+void Simulator::runDeferredGames(CompetitionSetup& setup) {
+    if (config_.isolation == "process") startProcessPool(setup);
+    if (config_.scheduler == "cost") {
+        runScheduledGames(setup);
+    } else {
+        auto& gmEntry = *GameManagerRegistrar::get().begin();
+        auto& algoReg = AlgorithmRegistrar::get();
+        for (const auto& [slot, mi] : setup.released) {
+            enqueueMapTasks(setup.maps[slot], mi, gmEntry, algoReg);
         }
+        metrics_.allQueued = true;
+        finalizeTaskExecution();
+    }
+    stopProcessPool();
+}
 
-        // for (size_t j = i + 1; j < loadedAlgorithms_; ++j) {
-        //     threadPool_->enqueue([this, &algoReg, &gmEntry, &realMap, cols, rows, mSteps, nShells, mapFile, i, j] {
-        //         executeCompetitionGame(algoReg, gmEntry, realMap, cols, rows, mSteps, nShells, mapFile, i, j);
-        //     });
-        // }
+// Cost-model scheduling (scheduler=cost)
+// All maps are loaded by now; enqueue every game longest-expected-first and
+// compare the predicted makespan with the one we actually get.
+void Simulator::runScheduledGames(CompetitionSetup& setup) {
+    std::vector<ScheduledGame> games = buildScheduledGames(setup);
+    CostScheduler::order(games);
+    const double predictedNs = CostScheduler::predictMakespanNs(games, threadPool_->size());
+
+    auto& gmEntry = *GameManagerRegistrar::get().begin();
+    auto& algoReg = AlgorithmRegistrar::get();
+    const auto start = std::chrono::steady_clock::now();
+    for (const ScheduledGame& g : games) {
+        enqueueCompetitionGame(setup.maps[g.map], g.i, g.j, gmEntry, algoReg);
+    }
+    metrics_.allQueued = true;
+    finalizeTaskExecution();
+    logMakespan(games, predictedNs, std::chrono::steady_clock::now() - start);
+}
+
+std::vector<ScheduledGame> Simulator::buildScheduledGames(const CompetitionSetup& setup) {
+    std::vector<std::pair<std::string, double>> mapUnits;
+    for (const auto& [slot, mi] : setup.released) {
+        const LoadedMap& m = setup.maps[slot];
+        mapUnits.emplace_back(baseName(m.file), CostScheduler::modelUnits(m.rows, m.cols, m.tanks, m.maxSteps));
+    }
+    costScheduler_->calibrate(mapUnits);
+
+    std::vector<ScheduledGame> games;
+    for (size_t k = 0; k < setup.released.size(); ++k) {
+        const auto [slot, mi] = setup.released[k];
+        const double predicted = costScheduler_->predictNs(mapUnits[k].first, mapUnits[k].second);
+        for (const auto& [i, j] : competitionPairings(mi)) {
+            if (claimCompetitionGame(setup.maps[slot], i, j)) games.push_back({slot, mi, i, j, predicted});
+        }
+    }
+    logDebug("SCHEDULER", "buildScheduledGames", "Scheduling " + std::to_string(games.size()) +
+             " game(s), " + std::to_string(costScheduler_->nsPerUnit()) + " ns per cost unit");
+    return games;
+}
+
+void Simulator::logMakespan(const std::vector<ScheduledGame>& games, double predictedNs,
+                            std::chrono::steady_clock::duration actual) const {
+    double predictedWork = 0;
+    for (const auto& g : games) predictedWork += g.predictedNs;
+    const double toMs = 1e-6;
+    const double actualMs = std::chrono::duration<double, std::milli>(actual).count();
+    std::ostringstream msg;
+    msg << std::fixed << std::setprecision(1)
+        << "Makespan predicted " << predictedNs * toMs << " ms, actual " << actualMs << " ms ("
+        << games.size() << " games on " << threadPool_->size() << " threads; work predicted "
+        << predictedWork * toMs << " ms, measured " << double(costScheduler_->runTotalNs()) * toMs << " ms)";
+    logInfo("SCHEDULER", "dispatchCompetitionTasks", msg.str());
+}
+
+void Simulator::saveScheduleHistory() const {
+    if (config_.schedule_history.empty()) return;
+    if (!costScheduler_->saveHistory()) {
+        logWarn("SCHEDULER", "saveScheduleHistory", "Cannot write schedule history '" + config_.schedule_history + "'");
+    } else {
+        logDebug("SCHEDULER", "saveScheduleHistory", "Updated schedule history " + config_.schedule_history);
     }
+}
+
+// Checkpointing (journal=<file>, resume=<file>)
+// resume= reads the journal and keeps appending to it unless journal= names
+// a different file.
+bool Simulator::openCompetitionJournal() {
+    const std::string& path = config_.journal.empty() ? config_.resume : config_.journal;
+    if (path.empty()) return true;
+
+    journal_ = std::make_unique<CompetitionJournal>();
+    if (!config_.resume.empty()) {
+        const size_t skipped = journal_->load(config_.resume);
+        if (skipped > 0) {
+            logWarn("JOURNAL", "openCompetitionJournal", "Ignored " + std::to_string(skipped) + " malformed line(s) in " + config_.resume);
+        }
+        logInfo("JOURNAL", "openCompetitionJournal", "Loaded " + std::to_string(journal_->loadedCount()) + " finished game(s) from " + config_.resume);
+    }
+    if (!journal_->open(path)) {
+        logError("JOURNAL", "openCompetitionJournal", "Cannot open journal '" + path + "' for appending");
+        return false;
+    }
+    return true;
+}
+
+JournalKey Simulator::journalKey(const std::string& mapFile, const std::string& algo1Name,
+                                 const std::string& algo2Name) const {
+    return {stripSoExtension(config_.game_manager), fs::path(mapFile).filename().string(), algo1Name, algo2Name};
+}
+
+// Live metrics (metrics_file=<file>)
+void Simulator::startMetricsReporter() {
+    if (config_.metrics_file.empty()) return;
+    metricsReporter_ = std::make_unique<MetricsReporter>(config_.metrics_file,
+        std::chrono::milliseconds(config_.metricsIntervalMs), metrics_, *threadPool_);
+    logInfo("METRICS", "startMetricsReporter", "Writing metrics to " + config_.metrics_file + " every " +
+            std::to_string(config_.metricsIntervalMs) + " ms");
+}
+
+void Simulator::stopMetricsReporter() {
+    if (!metricsReporter_) return;
+    if (!metricsReporter_->stop()) {
+        logWarn("METRICS", "stopMetricsReporter", "Cannot write metrics file '" + config_.metrics_file + "'");
+    }
+    metricsReporter_.reset();
+}
+
+// Result cache (result_cache=<dir>)
+// Plugins are hashed by content once, before any game runs.
+// A plugin that cannot be read has no trustworthy hash; its games bypass the cache.
+void Simulator::hashCompetitionPlugins() {
+    auto hash = [this](const std::string& path, std::uint64_t& out) {
+        const bool ok = ResultCache::hashFile(path, out);
+        if (!ok) logWarn("RESULTCACHE", "hashCompetitionPlugins", "Cannot read '" + path + "'; its games bypass the result cache");
+        return ok;
+    };
+    gameManagerHashed_ = hash(config_.game_manager, gameManagerHash_);
+    algorithmHashes_.assign(validAlgorithmPaths_.size(), 0);
+    algorithmHashed_.assign(validAlgorithmPaths_.size(), 0);
+    for (size_t k = 0; k < validAlgorithmPaths_.size(); ++k) {
+        algorithmHashed_[k] = hash(validAlgorithmPaths_[k], algorithmHashes_[k]);
+    }
+    logDebug("RESULTCACHE", "hashCompetitionPlugins", "Hashed " + std::to_string(algorithmHashes_.size() + 1) + " plugin(s)");
+}
+
+ResultCacheKey Simulator::resultCacheKey(std::uint64_t mapHash, size_t i, size_t j) const {
+    return {gameManagerHash_, mapHash, algorithmHashes_[i], algorithmHashes_[j],
+            config_.decisionTimeoutMs, config_.gameTimeoutMs};
+}
+
+bool Simulator::resultCacheable(size_t i, size_t j) const {
+    return resultCache_ && gameManagerHashed_ && algorithmHashed_[i] && algorithmHashed_[j];
+}
+
+// A game that ran out of time depends on machine load, so it is never cached
+void Simulator::storeCachedResult(std::uint64_t mapHash, size_t i, size_t j, const GameResult& gr,
+                                  size_t rows, size_t cols, const std::string& timeoutNote) const {
+    if (!resultCacheable(i, j) || !timeoutNote.empty()) return;
+    if (!resultCache_->store(resultCacheKey(mapHash, i, j), gr, rows, cols)) {
+        logWarn("RESULTCACHE", "storeCachedResult", "Could not write result cache entry in " + resultCache_->dir());
+    }
+}
+
+// Sharding (shard=i/n, -merge)
+// A game belongs to the shard its (map, algo1, algo2) names hash to, so every
+// process agrees on the partition without talking to the others.
+bool Simulator::inShard(const std::string& mapFile, size_t i, size_t j) const {
+    if (config_.shardCount <= 1) return true;
+    const std::string key = fs::path(mapFile).filename().string() + '\t' +
+                            stripSoExtension(validAlgorithmPaths_[i]) + '\t' +
+                            stripSoExtension(validAlgorithmPaths_[j]);
+    return MapCache::hashSource(key) % config_.shardCount == config_.shardIndex;
+}
+
+// Pairings depend on algorithm and valid-map order, so shards are only
+// mergeable if they all saw the same order
+std::string Simulator::competitionFingerprint(const CompetitionSetup& setup) const {
+    std::string text = stripSoExtension(config_.game_manager) + '\n';
+    for (const auto& path : validAlgorithmPaths_) text += stripSoExtension(path) + '\n';
+    text += setup.mapOrder;
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(MapCache::hashSource(text)));
+    return hex;
+}
+
+fs::path Simulator::shardFilePath(size_t index, size_t count) const {
+    return fs::path(config_.algorithms_folder) /
+           ("shard_" + std::to_string(index) + "of" + std::to_string(count) + ".txt");
+}
+
+bool Simulator::writeShardFile(const CompetitionTally& tally) const {
+    const fs::path outPath = shardFilePath(config_.shardIndex, config_.shardCount);
+    std::ofstream ofs(outPath);
+    if (!ofs.is_open()) {
+        logError("FILEWRITER", "writeShardFile", "Cannot create file " + outPath.string());
+        return false;
+    }
+    ofs << "# competition shard v1\n"
+        << "shard=" << config_.shardIndex << '/' << config_.shardCount << '\n'
+        << "game_maps_folder=" << config_.game_maps_folder << '\n'
+        << "game_manager=" << stripSoExtension(config_.game_manager) << '\n'
+        << "fingerprint=" << competitionFingerprint_ << '\n'
+        << "games=" << tally.games << '\n';
+    for (const auto& [name, t] : tally.algorithms) {
+        ofs << "A " << t.score << ' ' << t.wins << ' ' << t.losses << ' ' << t.ties << ' ' << name << '\n';
+    }
+    logInfo("FILEWRITER", "writeShardFile", "Shard results written to " + outPath.string());
+    return true;
+}
+
+bool Simulator::readShardFile(const fs::path& path, ShardResult& out) const {
+    std::ifstream in(path);
+    std::string line;
+    bool haveShard = false;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (line.rfind("A ", 0) == 0) {
+            std::istringstream ss(line.substr(2));
+            AlgorithmTally t;
+            std::string name;
+            if (!(ss >> t.score >> t.wins >> t.losses >> t.ties)) return false;
+            std::getline(ss >> std::ws, name);
+            if (name.empty()) return false;
+            out.tally.algorithms[name] = t;
+        } else if (line.rfind("shard=", 0) == 0) {
+            Config tmp;
+            if (!parseShard(line.substr(6), tmp)) return false;
+            out.index = tmp.shardIndex;
+            out.count = tmp.shardCount;
+            haveShard = true;
+        } else if (line.rfind("game_maps_folder=", 0) == 0) {
+            out.mapsFolder = line.substr(17);
+        } else if (line.rfind("game_manager=", 0) == 0) {
+            out.gameManager = line.substr(13);
+        } else if (line.rfind("fingerprint=", 0) == 0) {
+            out.fingerprint = line.substr(12);
+        } else if (line.rfind("games=", 0) == 0) {
+            out.tally.games = std::strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+    return haveShard && !out.fingerprint.empty();
+}
+
+bool Simulator::collectShardResults(std::vector<ShardResult>& shards) const {
+    for (const auto& e : fs::directory_iterator(config_.algorithms_folder)) {
+        const std::string name = e.path().filename().string();
+        if (!e.is_regular_file() || name.rfind("shard_", 0) != 0 || e.path().extension() != ".txt") continue;
+        ShardResult shard;
+        if (!readShardFile(e.path(), shard)) {
+            logError("MERGE", "runMerge", "Malformed shard result file " + e.path().string());
+            return false;
+        }
+        shards.push_back(std::move(shard));
+    }
+    std::sort(shards.begin(), shards.end(), [](const ShardResult& a, const ShardResult& b) { return a.index < b.index; });
+    return true;
+}
+
+// Exactly one result per shard index, all from the same split of the same competition
+bool Simulator::checkShardSet(const std::vector<ShardResult>& shards) const {
+    std::string problem;
+    if (shards.empty()) {
+        problem = "No shard result files in " + config_.algorithms_folder;
+    } else if (shards.size() != shards.front().count) {
+        problem = "Found " + std::to_string(shards.size()) + " shard result(s), expected " + std::to_string(shards.front().count);
+    }
+    for (size_t k = 0; problem.empty() && k < shards.size(); ++k) {
+        const ShardResult& s = shards[k];
+        if (s.count != shards.front().count || s.index != k) {
+            problem = "Shard results do not form one complete split (missing or duplicate shard " + std::to_string(k) + ")";
+        } else if (s.fingerprint != shards.front().fingerprint || s.gameManager != shards.front().gameManager) {
+            problem = "Shard " + std::to_string(k) + " ran a different competition (maps, algorithms or GameManager differ)";
+        }
+    }
+    if (!problem.empty()) {
+        logError("MERGE", "runMerge", problem);
+        return false;
+    }
+    return true;
+}
+
+int Simulator::runMerge() {
+    logInfo("SIMULATOR", "runMerge", "Merging shard results in " + config_.algorithms_folder);
+    std::vector<ShardResult> shards;
+    if (!collectShardResults(shards) || !checkShardSet(shards)) {
+        return 1;
+    }
+    for (const ShardResult& s : shards) {
+        competitionTally_.games += s.tally.games;
+        for (const auto& [name, t] : s.tally.algorithms) {
+            AlgorithmTally& sum = competitionTally_.algorithms[name];
+            sum.score += t.score;
+            sum.wins += t.wins;
+            sum.losses += t.losses;
+            sum.ties += t.ties;
+        }
+    }
+    config_.game_maps_folder = shards.front().mapsFolder;
+    config_.game_manager = shards.front().gameManager;
+    writeCompetitionFile(competitionTally_);
+    logCompetitionSummary();
+    return 0;
+}
+
+size_t Simulator::countTanks(const SatelliteView& view, size_t rows, size_t cols) {
+    size_t tanks = 0;
+    for (size_t y = 0; y < rows; ++y) {
+        for (size_t x = 0; x < cols; ++x) {
+            const char c = view.getObjectAt(x, y);
+            tanks += (c == '1' || c == '2');
+        }
+    }
+    return tanks;
+}
 
 void Simulator::executeCompetitionGame(AlgorithmRegistrar& algoReg, const auto& gmEntry,
                                       SatelliteView& realMap, size_t cols, size_t rows,
                                       size_t mSteps, size_t nShells, const std::string& mapFile,
-                                      size_t i, size_t j) {
+                                      std::uint64_t mapHash, size_t i, size_t j) {
     const std::string algo1Name = stripSoExtension(validAlgorithmPaths_[i]);
     const std::string algo2Name = stripSoExtension(validAlgorithmPaths_[j]);
     const std::string gmName = stripSoExtension(config_.game_manager);
 
-
+    CompetitionMetrics::GameScope game(metrics_);
     try {
+        const auto start = std::chrono::steady_clock::now();
         GameResult gr = runCompetitionGame(algoReg, gmEntry, realMap, cols, rows, 
                                           mSteps, nShells, mapFile, algo1Name, algo2Name, i, j);
-        
-        std::lock_guard<std::mutex> lock(resultsMutex_);
-        competitionResults_.emplace_back(mapFile, algo1Name, algo2Name, std::move(gr));
-        totalGamesPlayed_++;
+        if (costScheduler_) {
+            costScheduler_->record(baseName(mapFile), static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        }
+        // The GameManager keeps the profile per thread, so fetch it on this worker
+        GameProfile profile;
+        const bool hasProfile = profileFetch_ && profileFetch_(&profile) != 0;
+        const std::string timeout = fetchGameTimeout(0);
+        storeCachedResult(mapHash, i, j, gr, rows, cols, timeout);
+        recordCompetitionResult(mapFile, algo1Name, algo2Name, std::move(gr), hasProfile ? &profile : nullptr,
+                                rows, cols, timeout);
+        game.ok = true;
     } catch (const std::exception& ex) {
         ErrorLogger::instance().logGameManagerError(mapFile, algo1Name, algo2Name, gmName + "': " + std::string(ex.what()));
     } catch (...) {
@@ -1005,6 +1529,129 @@ void Simulator::executeCompetitionGame(AlgorithmRegistrar& algoReg, const auto&
     }
 }
 
+// Fold one finished game into the journal and the running tallies
+void Simulator::recordCompetitionResult(const std::string& mapFile, const std::string& algo1Name,
+                                        const std::string& algo2Name, GameResult&& gr,
+                                        const GameProfile* profile, size_t rows, size_t cols,
+                                        const std::string& timeoutNote) {
+    logInfo("RESULTS", "runCompetition", "Map=" + mapFile + " A1=" + algo1Name + " A2=" + algo2Name + " => winner=" + std::to_string(gr.winner) + " reason=" + std::to_string(static_cast<int>(gr.reason)) + " rounds=" + std::to_string(gr.rounds) + (timeoutNote.empty() ? "" : " (timeout)"));
+    if (!timeoutNote.empty()) {
+        logWarn("WATCHDOG", "recordCompetitionResult", "Map=" + mapFile + " A1=" + algo1Name + " A2=" + algo2Name + ": " + timeoutNote);
+    }
+    tallyCompetitionResult(mapFile, algo1Name, algo2Name, std::move(gr), profile, rows, cols);
+}
+
+void Simulator::tallyCompetitionResult(const std::string& mapFile, const std::string& algo1Name,
+                                       const std::string& algo2Name, GameResult&& gr,
+                                       const GameProfile* profile, size_t rows, size_t cols) {
+
+    if (journal_) {
+        journal_->append(journalKey(mapFile, algo1Name, algo2Name),
+                         {gr.winner, static_cast<int>(gr.reason), gr.rounds});
+    }
+    std::lock_guard<std::mutex> lock(resultsMutex_);
+    competitionTally_.record(algo1Name, algo2Name, gr.winner);
+    if (profile) competitionTally_.recordProfile(baseName(mapFile), algo1Name, algo2Name, *profile);
+    if (config_.keepFinalBoards) {
+        competitionResults_.emplace_back(mapFile, algo1Name, algo2Name, std::move(gr));
+        competitionResults_.back().rows = rows;
+        competitionResults_.back().cols = cols;
+    }
+    totalGamesPlayed_++;
+}
+
+// Crash isolation (isolation=process)
+// Forked only now, with every map loaded, so the workers inherit plugins
+// and maps. The fork-server is still forked from this multithreaded
+// process: the pool threads are alive but parked (the pool is idle), and
+// the metrics reporter is held between snapshots across the fork. The
+// children only take debugMutex_ and the ErrorLogger's lock, which none of
+// those threads can be holding at that moment.
+void Simulator::startProcessPool(const CompetitionSetup& setup) {
+    if (config_.keepFinalBoards) {
+        logWarn("PROCESSPOOL", "startProcessPool", "Final boards stay in the worker processes; -keep_final_boards has no effect");
+    }
+    std::cout.flush();
+    std::fflush(nullptr);
+    setExitOnHang(true);
+    {
+        std::unique_lock<std::mutex> quiet;
+        if (metricsReporter_) quiet = metricsReporter_->holdSnapshots();
+        processPool_ = std::make_unique<ProcessPool>(config_.numThreads,
+            [this, &setup](const IsolatedGameRequest& req) { return runIsolatedGame(setup, req); });
+    }
+    if (!processPool_->ok()) {
+        logWarn("PROCESSPOOL", "startProcessPool", "Cannot start worker processes, running games in-process");
+        processPool_.reset();
+        setExitOnHang(false);
+        return;
+    }
+    logInfo("PROCESSPOOL", "startProcessPool", "Running games in " + std::to_string(config_.numThreads) + " worker process(es)");
+}
+
+void Simulator::stopProcessPool() {
+    if (!processPool_) return;
+    const size_t crashes = processPool_->crashes();
+    processPool_.reset();
+    if (crashes > 0) {
+        logWarn("PROCESSPOOL", "stopProcessPool", std::to_string(crashes) + " worker process(es) crashed and were replaced");
+    }
+}
+
+// Parent side: one pool thread per in-flight worker process
+void Simulator::executeIsolatedGame(const LoadedMap& map, size_t i, size_t j) {
+    const std::string algo1Name = stripSoExtension(validAlgorithmPaths_[i]);
+    const std::string algo2Name = stripSoExtension(validAlgorithmPaths_[j]);
+    const std::string gmName = stripSoExtension(config_.game_manager);
+
+    CompetitionMetrics::GameScope game(metrics_);
+    const auto start = std::chrono::steady_clock::now();
+    IsolatedGameOutcome out = processPool_->run(map.slot, i, j, isolatedHardLimit());
+    game.ok = out.status == IsolatedGameOutcome::OK;
+    if (out.status != IsolatedGameOutcome::OK) {
+        if (out.status == IsolatedGameOutcome::TIMED_OUT) {
+            logInfo("RESULTS", "runCompetition", "Map=" + map.file + " A1=" + algo1Name + " A2=" + algo2Name + " => timed out, not scored");
+        }
+        if (out.status != IsolatedGameOutcome::ERROR) {
+            logWarn("PROCESSPOOL", "executeIsolatedGame", "Map=" + map.file + " A1=" + algo1Name + " A2=" + algo2Name + ": " + out.error);
+        }
+        ErrorLogger::instance().logGameManagerError(map.file, algo1Name, algo2Name, gmName + "': " + out.error);
+        return;
+    }
+    if (costScheduler_) {
+        costScheduler_->record(baseName(map.file), static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+    }
+    GameResult gr{};
+    gr.winner = out.winner;
+    gr.reason = static_cast<GameResult::Reason>(out.reason);
+    gr.rounds = out.rounds;
+    recordCompetitionResult(map.file, algo1Name, algo2Name, std::move(gr),
+                            out.hasProfile ? &out.profile : nullptr, map.rows, map.cols, out.timeout);
+}
+
+// Worker side: runs inside a forked process; exceptions become ERROR outcomes
+IsolatedGameOutcome Simulator::runIsolatedGame(const CompetitionSetup& setup, const IsolatedGameRequest& req) {
+    const LoadedMap& map = setup.maps[req.map];
+    auto& algoReg = AlgorithmRegistrar::get();
+    auto& gmEntry = *GameManagerRegistrar::get().begin();
+    const std::string algo1Name = stripSoExtension(validAlgorithmPaths_[req.i]);
+    const std::string algo2Name = stripSoExtension(validAlgorithmPaths_[req.j]);
+
+    GameResult gr = runCompetitionGame(algoReg, gmEntry, *map.view, map.cols, map.rows, map.maxSteps,
+                                       map.numShells, map.file, algo1Name, algo2Name, req.i, req.j);
+    IsolatedGameOutcome out;
+    out.status = IsolatedGameOutcome::OK;
+    out.winner = gr.winner;
+    out.reason = static_cast<int>(gr.reason);
+    out.rounds = gr.rounds;
+    out.hasProfile = profileFetch_ && profileFetch_(&out.profile) != 0;
+    const std::string timeout = fetchGameTimeout(0);
+    std::snprintf(out.timeout, sizeof(out.timeout), "%s", timeout.c_str());
+    storeCachedResult(map.contentHash, req.i, req.j, gr, map.rows, map.cols, timeout);   // the final board never leaves the worker
+    return out;
+}
+
 GameResult Simulator::runCompetitionGame(AlgorithmRegistrar& algoReg, const auto& gmEntry,
                                         SatelliteView& realMap, size_t cols, size_t rows,
                                         size_t mSteps, size_t nShells, const std::string& mapFile,
@@ -1028,15 +1675,9 @@ GameResult Simulator::runCompetitionGame(AlgorithmRegistrar& algoReg, const auto
     );
 }
 
-size_t Simulator::calculateTotalGames(size_t numMaps) {
-    size_t totalGames = numMaps * loadedAlgorithms_;
-    return totalGames;
-}
-
 void Simulator::finalizeTaskExecution() {
     logInfo("THREADPOOL", "dispatchComparativeTasks", "All tasks enqueued, waiting for completion");
-    threadPool_->shutdown();
-    threadPool_ = std::make_unique<ThreadPool>(config_.numThreads);
+    threadPool_->waitIdle();
 }
 
 // // Comparative results file writing
@@ -1248,69 +1889,22 @@ std::string Simulator::outcomeMessage(int winner, GameResult::Reason reason) con
 }
 
 // Enhanced map preprocessing that tracks valid maps
-std::vector<std::shared_ptr<SatelliteView>> Simulator::preloadMapsAndTrackValid(
-    const std::vector<std::string>& mapFiles,
-    std::vector<std::string>& validMapFiles,
-    std::vector<size_t>& mapRows,
-    std::vector<size_t>& mapCols, 
-    std::vector<size_t>& mapMaxSteps,
-    std::vector<size_t>& mapNumShells) const {
-    
-    std::vector<std::shared_ptr<SatelliteView>> mapViews;
-    
-    logDebug("SIMULATOR", "preloadMapsAndTrackValid", "Preloading map data into shared structures");
-    
-    for (const auto& mapFile : mapFiles) {
-        try {
-            MapData md = loadMapWithParams(mapFile);
-            mapViews.emplace_back(std::move(md.view));
-            mapCols.push_back(md.cols);
-            mapRows.push_back(md.rows);
-            mapMaxSteps.push_back(md.maxSteps);
-            mapNumShells.push_back(md.numShells);
-            validMapFiles.push_back(mapFile); // Only add if successful
-            logDebug("MAPLOADER", "preloadMapsAndTrackValid", "Successfully preloaded map: " + mapFile);
-        } catch (const std::exception& ex) {
-            std::string warnMsg = "Skipping invalid map '" + mapFile + "': " + std::string(ex.what());
-            logWarn("MAPLOADER", "preloadMapsAndTrackValid", warnMsg);
-        }
-    }
-    logInfo("SIMULATOR", "preloadMapsAndTrackValid", "Successfully preloaded " + std::to_string(mapViews.size()) + " valid map(s)");
-    
-    return mapViews;
-}
 
 // Competition results file writing
-bool Simulator::writeCompetitionFile(const std::vector<CompetitionEntry>& results) const {
+bool Simulator::writeCompetitionFile(const CompetitionTally& tally) const {
     logInfo("FILEWRITER", "writeCompetitionFile", "Writing competition results file");
 
-    auto scores = calculateScores(results);
+    auto scores = calculateScores(tally);
     auto sorted = sortScoresByDescending(scores);
     auto outPath = buildOutputPath();
 
     return writeToFile(outPath, sorted) || writeToStdout(sorted);
 }
 
-std::map<std::string, int> Simulator::calculateScores(const std::vector<CompetitionEntry>& results) const {
+std::map<std::string, int> Simulator::calculateScores(const CompetitionTally& tally) const {
     std::map<std::string, int> scores;
-    for (const auto& entry : results) {
-        // Only initialize if not already in map
-        if (scores.find(entry.a1) == scores.end()) {
-            scores[entry.a1] = 0;
-        }
-        if (scores.find(entry.a2) == scores.end()) {
-            scores[entry.a2] = 0;
-        }
-        
-        int w = entry.res.winner;
-        if (w == 1) {
-            scores[entry.a1] += 3;
-        } else if (w == 2) {
-            scores[entry.a2] += 3;
-        } else {
-            scores[entry.a1] += 1;
-            scores[entry.a2] += 1;
-        }
+    for (const auto& [name, t] : tally.algorithms) {
+        scores[name] = t.score;
     }
     
     logDebug("FILEWRITER", "writeCompetitionFile", 
@@ -1361,6 +1955,137 @@ void Simulator::writeContent(std::ostream& os,
     }
 }
 
+// Profiling (-profile)
+void Simulator::enableGameManagerProfiling(void* gmHandle) {
+    auto enable = reinterpret_cast<GameProfileEnableFn>(dlsym(gmHandle, kGameProfileEnableSymbol));
+    auto fetch  = reinterpret_cast<GameProfileFetchFn>(dlsym(gmHandle, kGameProfileFetchSymbol));
+    if (!enable || !fetch) {
+        logWarn("PROFILER", "enableGameManagerProfiling",
+                "GameManager does not export profiling hooks; -profile ignored");
+        return;
+    }
+    cyclesPerNs_  = calibrateCyclesPerNs();
+    profileFetch_ = fetch;
+    enable(1);
+    logInfo("PROFILER", "enableGameManagerProfiling", "Profiling enabled");
+}
+
+// Time budgets (decision_timeout_ms / game_timeout_ms)
+// The GameManager enforces them cooperatively; one lacking the hook runs unlimited.
+void Simulator::applyGameLimits(void* gmHandle) {
+    GameLimitsFn set = nullptr;
+    GameTimeoutFetchFn fetch = nullptr;
+    if (config_.decisionTimeoutMs > 0 || config_.gameTimeoutMs > 0) {
+        set   = reinterpret_cast<GameLimitsFn>(dlsym(gmHandle, kGameLimitsSymbol));
+        fetch = reinterpret_cast<GameTimeoutFetchFn>(dlsym(gmHandle, kGameTimeoutFetchSymbol));
+        if (set && fetch) {
+            const GameLimits limits{config_.decisionTimeoutMs, config_.gameTimeoutMs};
+            set(&limits);
+            logInfo("WATCHDOG", "applyGameLimits", "Time budgets: decision " + std::to_string(limits.decisionMs) +
+                    " ms, game " + std::to_string(limits.gameMs) + " ms (0 = unlimited)");
+        } else {
+            set = nullptr;
+            fetch = nullptr;
+            logWarn("WATCHDOG", "applyGameLimits", "GameManager does not export time budget hooks; timeouts ignored");
+        }
+    }
+    limitsSet_.push_back(set);
+    timeoutFetch_.push_back(fetch);
+}
+
+// Set around forking the worker pool: a call that never returns ends its
+// worker (reported TIMED_OUT) rather than holding it, and the run, forever
+void Simulator::setExitOnHang(bool on) const {
+    const GameLimits limits{config_.decisionTimeoutMs, config_.gameTimeoutMs, on ? 1u : 0u};
+    for (GameLimitsFn set : limitsSet_) {
+        if (set) set(&limits);
+    }
+}
+
+// Replay recording (replay_file=<file>)
+// Only games that would write a text log are recorded, so it needs -verbose.
+void Simulator::applyReplayOutput(void* gmHandle) {
+    if (config_.replay_file.empty()) return;
+    if (!config_.verbose) {
+        logWarn("REPLAY", "applyReplayOutput", "replay_file is only written with -verbose; ignored");
+        return;
+    }
+    auto set = reinterpret_cast<GameReplayFn>(dlsym(gmHandle, kGameReplaySymbol));
+    if (!set) {
+        logWarn("REPLAY", "applyReplayOutput", "GameManager does not export the replay hook; writing text logs");
+    } else if (!set(config_.replay_file.c_str())) {
+        logWarn("REPLAY", "applyReplayOutput", "Cannot open replay file '" + config_.replay_file + "'; writing text logs");
+    } else {
+        logInfo("REPLAY", "applyReplayOutput", "Recording games to " + config_.replay_file);
+    }
+}
+
+// Last game on this thread (the GameManager keeps it per thread); empty if it ran within budget
+std::string Simulator::fetchGameTimeout(size_t gi) const {
+    if (gi >= timeoutFetch_.size() || !timeoutFetch_[gi]) return {};
+    char note[256] = {};
+    return timeoutFetch_[gi](note, sizeof(note)) != 0 ? std::string(note) : std::string();
+}
+
+// isolation=process backstop for a game that never yields to the cooperative
+// checks: its worker is killed well after the game budget would have ended it.
+// A single hung decision is caught sooner, by the worker's own watchdog
+// (setExitOnHang), so a decision budget alone needs no limit here.
+std::chrono::milliseconds Simulator::isolatedHardLimit() const {
+    if (config_.gameTimeoutMs == 0) return std::chrono::milliseconds::zero();
+    return std::chrono::milliseconds(2 * config_.gameTimeoutMs + 1000);
+}
+
+bool Simulator::writeProfileFile(const CompetitionTally& tally) const {
+    if (!profileFetch_) return false;
+    fs::path outPath = fs::path(config_.algorithms_folder) / ("profile_" + currentTimestamp() + ".txt");
+    std::ofstream ofs(outPath);
+    if (!ofs.is_open()) {
+        std::string warnMsg = "Cannot create file " + outPath.string() + ", falling back to stdout";
+        logWarn("FILEWRITER", "writeProfileFile", warnMsg);
+        writeProfileContent(std::cout, tally);
+        return false;
+    }
+    logInfo("FILEWRITER", "writeProfileFile", "Writing to file: " + outPath.string());
+    writeProfileContent(ofs, tally);
+    return true;
+}
+
+void Simulator::writeProfileContent(std::ostream& os, const CompetitionTally& tally) const {
+    os << "game_maps_folder=" << config_.game_maps_folder << "\n";
+    os << "game_manager=" << stripSoExtension(config_.game_manager) << "\n";
+    os << "profiled_games=" << tally.profiledGames << "\n";
+    os << std::fixed << std::setprecision(3) << "cycles_per_ns=" << cyclesPerNs_ << "\n";
+    os << "# 'gather' includes algorithm_calls; algorithm groups count only their own side's calls\n\n";
+    writeProfileSection(os, "map", tally.profilePerMap);
+    writeProfileSection(os, "algorithm", tally.profilePerAlgo);
+}
+
+// One block per group: phase totals (ms), ns per turn and share of engine time,
+// then the time spent inside the group's algorithm calls.
+void Simulator::writeProfileSection(std::ostream& os, const std::string& title,
+                                    const std::map<std::string, ProfileTotals>& groups) const {
+    const double nsPerCycle = cyclesPerNs_ > 0 ? 1.0 / cyclesPerNs_ : 1.0;
+    for (const auto& [name, t] : groups) {
+        std::uint64_t engine = 0;
+        for (auto c : t.phaseCycles) engine += c;
+        const double turns = t.turns ? double(t.turns) : 1.0;
+        os << title << "=" << name << " games=" << t.games << " turns=" << t.turns << "\n";
+        for (size_t i = 0; i < GameProfile::kPhaseCount; ++i) {
+            const double ns = double(t.phaseCycles[i]) * nsPerCycle;
+            os << "  " << std::left << std::setw(16) << GameProfile::kPhaseNames[i] << std::right
+               << std::setprecision(3) << std::setw(12) << ns / 1e6 << " ms"
+               << std::setprecision(1) << std::setw(12) << ns / turns << " ns/turn"
+               << std::setw(8) << (engine ? 100.0 * double(t.phaseCycles[i]) / double(engine) : 0.0) << " %\n";
+        }
+        const double algoNs = double(t.algoCycles) * nsPerCycle;
+        os << "  " << std::left << std::setw(16) << "algorithm_calls" << std::right
+           << std::setprecision(3) << std::setw(12) << algoNs / 1e6 << " ms"
+           << std::setprecision(1) << std::setw(12) << (t.algoCalls ? algoNs / double(t.algoCalls) : 0.0)
+           << " ns/call  calls=" << t.algoCalls << "\n\n";
+    }
+}
+
 // Utility methods
 std::string Simulator::stripSoExtension(const std::string& path) const {
     auto fname = fs::path(path).filename().string();
@@ -8,12 +8,25 @@
 #include <mutex>
 #include <set> 
 #include <filesystem>
+#include <bitset>
+#include <string_view>
+#include <chrono>
 namespace fs = std::filesystem;
 // Include required headers instead of forward declarations for member variables
 #include "ArgParser.h"     // For Config struct
 #include "GameResult.h"    // For GameResult struct
 #include "AlgorithmRegistrar.h"
 #include "GameManagerRegistrar.h"
+#include "GameProfile.h"   // per-game timings exported by the GameManager
+#include "GameLimits.h"    // per-game time budgets enforced by the GameManager
+#include "GameReplay.h"    // binary replay container written by the GameManager
+#include "MappedFile.h"
+#include "MapCache.h"
+#include "CostScheduler.h"
+#include "CompetitionJournal.h"
+#include "ProcessPool.h"
+#include "ResultCache.h"
+#include "CompetitionMetrics.h"
 // Forward declarations for pointers/references only
 class SatelliteView;
 class ThreadPool;
@@ -32,16 +45,74 @@ struct CompetitionEntry {
     std::string mapFile;
     std::string a1, a2;
     GameResult  res;
+    size_t      rows = 0, cols = 0;   // final board size
     
     CompetitionEntry(std::string m, std::string x, std::string y, GameResult r);
 };
 
+// Profile totals over a group of games (one map, or one algorithm)
+struct ProfileTotals {
+    size_t        games = 0;
+    std::uint64_t turns = 0;
+    std::uint64_t phaseCycles[UserCommon_315634022::GameProfile::kPhaseCount] = {};
+    std::uint64_t algoCycles = 0, algoCalls = 0;
+
+    // side: 0/1 counts only that player's algorithm time, -1 counts both
+    void add(const UserCommon_315634022::GameProfile& p, int side);
+};
+
+// Running totals for one algorithm in competition mode
+struct AlgorithmTally {
+    int    score = 0;
+    size_t wins = 0, losses = 0, ties = 0;
+};
+
+// Competition results folded in as each game finishes, so memory stays flat
+// no matter how many games run. Keyed by name, so iteration order is stable.
+struct CompetitionTally {
+    size_t games = 0, profiledGames = 0;
+    std::map<std::string, AlgorithmTally> algorithms;
+    std::map<std::string, ProfileTotals>  profilePerMap, profilePerAlgo;
+
+    void record(const std::string& a1, const std::string& a2, int winner);
+    void recordProfile(const std::string& mapName, const std::string& a1, const std::string& a2,
+                       const UserCommon_315634022::GameProfile& profile);
+};
+
+// One shard's contribution to a sharded competition (shard_<i>of<n>.txt)
+struct ShardResult {
+    size_t index = 0, count = 1;
+    std::string mapsFolder, gameManager;
+    std::string fingerprint;   // hash of GM, algorithm and valid-map order; must match across shards
+    CompetitionTally tally;
+};
+
 // Competition setup struct
+// One map file of the competition, filled in by its load task
+struct LoadedMap {
+    std::string file;
+    size_t slot = 0;       // index in CompetitionSetup::maps
+    std::unique_ptr<SatelliteView> view;
+    size_t rows = 0, cols = 0, maxSteps = 0, numShells = 0;
+    size_t tanks = 0;      // counted only for scheduler=cost
+    std::uint64_t contentHash = 0;   // source hash, only with map_cache or result_cache
+    bool loaded = false;   // load task finished (valid or not)
+};
+
+// Competition maps load in parallel on the pool. Maps are released to game
+// dispatch strictly in file order through `frontier`, so every valid map
+// gets the same index (and thus the same pairings) as a sequential load.
 struct CompetitionSetup {
-    std::vector<std::string> allMapFiles;
-    std::vector<std::string> validMapFiles;
-    std::vector<std::shared_ptr<SatelliteView>> mapViews;
-    std::vector<size_t> mapRows, mapCols, mapMaxSteps, mapNumShells;
+    std::vector<LoadedMap> maps;        // sized once; tasks hold references into it
+    std::mutex             mutex;       // guards loaded flags, frontier, validMaps, queuedMaps
+    size_t                 frontier = 0;
+    size_t                 validMaps = 0;
+    size_t                 queuedMaps = 0;  // released maps whose games are all enqueued
+    // scheduler=cost / isolation=process: games are held back until every
+    // map is loaded; these are the released maps as (slot, valid-map index)
+    bool                   deferGames = false;
+    std::vector<std::pair<size_t, size_t>> released;
+    std::string            mapOrder;    // valid map file names in index order, '\n'-terminated
 };
 
 
@@ -49,15 +120,24 @@ struct MapData {
     std::unique_ptr<SatelliteView> view;
     size_t rows, cols;
     size_t maxSteps, numShells;
+    std::uint64_t contentHash = 0;   // source hash, only with map_cache or result_cache
 };
 
 struct MapParameters {
     size_t rows = 0, cols = 0, maxSteps = 0, numShells = 0;
     bool foundRows = false, foundCols = false, foundMaxSteps = false, foundNumShells = false;
-    std::vector<std::string> rawGridLines;
+    bool headerWarnings = false;   // warned about header lines; such maps are not cached
     std::string path; 
 };
 
+// Grid as produced by the single-pass scan, plus what the file really held
+struct MapGrid {
+    std::string      cells;              // rows*cols cleaned cells, row-major
+    size_t           fileRows = 0;       // grid lines in the file
+    size_t           maxFileCols = 0;    // longest grid line
+    std::bitset<256> invalidChars;       // byte values replaced with ' '
+};
+
 class Simulator {
 public:
     // Constructor
@@ -72,6 +152,7 @@ public:
     // Mode-specific execution
     int runComparative();
     int runCompetition();
+    int runMerge();
     
     // Configuration access
     const Config& getConfig() const { return config_; }
@@ -105,20 +186,40 @@ private:
                                 const std::string& mapFile, const std::string& algo1Name,
                                 const std::string& algo2Name);
     std::string buildFinalMapString(const GameResult& gr, const MapData& md);
-    CompetitionSetup prepareCompetitionData();
-    void enqueueCompetitionTasks(const CompetitionSetup& setup);
-    void enqueueMapTasks(const CompetitionSetup& setup, size_t mi, const auto& gmEntry, AlgorithmRegistrar& algoReg);
+    void prepareCompetitionData(CompetitionSetup& setup);
+    void enqueueCompetitionTasks(CompetitionSetup& setup);
+    void loadCompetitionMap(CompetitionSetup& setup, size_t fi, const auto& gmEntry, AlgorithmRegistrar& algoReg);
+    void advanceMapFrontier(CompetitionSetup& setup, size_t fi, const auto& gmEntry, AlgorithmRegistrar& algoReg);
+    void enqueueMapTasks(const LoadedMap& map, size_t mi, const auto& gmEntry, AlgorithmRegistrar& algoReg);
+    std::vector<std::pair<size_t, size_t>> competitionPairings(size_t mi) const;
+    bool claimCompetitionGame(const LoadedMap& map, size_t i, size_t j);
+    bool resumeCompetitionGame(const LoadedMap& map, size_t i, size_t j);
+    bool cachedCompetitionGame(const LoadedMap& map, size_t i, size_t j);
+    void enqueueCompetitionGame(const LoadedMap& map, size_t i, size_t j, const auto& gmEntry, AlgorithmRegistrar& algoReg);
     void executeCompetitionGame(AlgorithmRegistrar& algoReg, const auto& gmEntry,
                             SatelliteView& realMap, size_t cols, size_t rows,
                             size_t mSteps, size_t nShells, const std::string& mapFile,
-                            size_t i, size_t j);
+                            std::uint64_t mapHash, size_t i, size_t j);
     GameResult runCompetitionGame(AlgorithmRegistrar& algoReg, const auto& gmEntry,
                                 SatelliteView& realMap, size_t cols, size_t rows,
                                 size_t mSteps, size_t nShells, const std::string& mapFile,
                                 const std::string& algo1Name, const std::string& algo2Name,
                                 size_t i, size_t j);
-    size_t calculateTotalGames(size_t numMaps);
     void finalizeTaskExecution();
+    void recordCompetitionResult(const std::string& mapFile, const std::string& algo1Name,
+                                 const std::string& algo2Name, GameResult&& gr,
+                                 const UserCommon_315634022::GameProfile* profile,
+                                 size_t rows, size_t cols, const std::string& timeoutNote);
+    void tallyCompetitionResult(const std::string& mapFile, const std::string& algo1Name,
+                                const std::string& algo2Name, GameResult&& gr,
+                                const UserCommon_315634022::GameProfile* profile,
+                                size_t rows, size_t cols);
+    void runDeferredGames(CompetitionSetup& setup);
+    // Crash isolation (isolation=process)
+    void startProcessPool(const CompetitionSetup& setup);
+    void stopProcessPool();
+    void executeIsolatedGame(const LoadedMap& map, size_t i, size_t j);
+    IsolatedGameOutcome runIsolatedGame(const CompetitionSetup& setup, const IsolatedGameRequest& req);
 
     // GameManager loading helpers
     void loadGameManagersFromDirectory(GameManagerRegistrar& gmReg);
@@ -138,47 +239,106 @@ private:
     void handleValidationError(const std::string& errorMsg, AlgorithmRegistrar& algoReg, void* handle, bool failOnError);
     void finalizeAlgorithmLoad(void* handle, const std::string& algPath, const std::string& name);
     // Map loading helpers
-    std::ifstream openMapFile(const std::string& path) const;
-    MapParameters parseMapParameters(std::ifstream& in, const std::string& path) const;
+    MappedFile openMapFile(const std::string& path) const;
+    size_t parseMapHeader(std::string_view text, MapParameters& params) const;
     bool processMapLine(const std::string& line, MapParameters& params, int lineNumber, const std::string& path) const;
     bool tryParseParameter(const std::string& line, const std::string& paramName, size_t& value, bool& found, const std::string& path) const;
     bool looksLikeParameter(const std::string& line) const;
     void validateMapParameters(const MapParameters& params, const std::string& path) const;
     void checkRequiredHeaders(const MapParameters& params, const std::string& path) const;
     void validateDimensions(const MapParameters& params, const std::string& path) const;
-    void checkDimensionMismatches(const MapParameters& params, const std::string& path) const;
-    std::vector<std::string> createNormalizedGrid(const MapParameters& params) const;
-    MapData buildMapData(const MapParameters& params, std::vector<std::string>&& normalizedGrid) const;
-    void cleanLine(std::string& line) const;
-    void logNormalizedGrid(const std::vector<std::string>& normalizedGrid) const;
+    void checkDimensionMismatches(const MapParameters& params, const MapGrid& grid, const std::string& path) const;
+    MapGrid scanGrid(std::string_view text, size_t pos, const MapParameters& params) const;
+    void logGridWarnings(const MapParameters& params, const MapGrid& grid) const;
+    MapData buildMapData(const MapParameters& params, MapGrid&& grid) const;
+    void logNormalizedGrid(const MapGrid& grid, size_t cols) const;
+    // Cost-model scheduling (scheduler=cost)
+    void runScheduledGames(CompetitionSetup& setup);
+    std::vector<ScheduledGame> buildScheduledGames(const CompetitionSetup& setup);
+    void logMakespan(const std::vector<ScheduledGame>& games, double predictedNs,
+                     std::chrono::steady_clock::duration actual) const;
+    void saveScheduleHistory() const;
+    static size_t countTanks(const SatelliteView& view, size_t rows, size_t cols);
+    // Checkpointing (journal=<file>, resume=<file>)
+    bool openCompetitionJournal();
+    JournalKey journalKey(const std::string& mapFile, const std::string& algo1Name,
+                          const std::string& algo2Name) const;
+    // Live metrics (metrics_file=<file>)
+    void startMetricsReporter();
+    void stopMetricsReporter();
+    // Result cache (result_cache=<dir>)
+    void hashCompetitionPlugins();
+    ResultCacheKey resultCacheKey(std::uint64_t mapHash, size_t i, size_t j) const;
+    bool resultCacheable(size_t i, size_t j) const;
+    void storeCachedResult(std::uint64_t mapHash, size_t i, size_t j, const GameResult& gr,
+                           size_t rows, size_t cols, const std::string& timeoutNote) const;
+    // Sharding (shard=i/n, -merge)
+    bool inShard(const std::string& mapFile, size_t i, size_t j) const;
+    std::string competitionFingerprint(const CompetitionSetup& setup) const;
+    fs::path shardFilePath(size_t index, size_t count) const;
+    bool writeShardFile(const CompetitionTally& tally) const;
+    bool readShardFile(const fs::path& path, ShardResult& out) const;
+    bool collectShardResults(std::vector<ShardResult>& shards) const;
+    bool checkShardSet(const std::vector<ShardResult>& shards) const;
+    // Compiled map cache (map_cache=<dir>)
+    MapData buildCachedMapData(const std::string& path, MapCache::Entry& entry) const;
+    void storeCachedMap(std::uint64_t hash, size_t sourceSize,
+                        const MapParameters& params, const MapGrid& grid) const;
     // Competition file writing helpers
-    std::map<std::string, int> calculateScores(const std::vector<CompetitionEntry>& results) const;
+    std::map<std::string, int> calculateScores(const CompetitionTally& tally) const;
     std::vector<std::pair<std::string, int>> sortScoresByDescending(const std::map<std::string, int>& scores) const;
     fs::path buildOutputPath() const;
     bool writeToFile(const fs::path& outPath, const std::vector<std::pair<std::string, int>>& sorted) const;
     bool writeToStdout(const std::vector<std::pair<std::string, int>>& sorted) const;
     void writeContent(std::ostream& os, const std::vector<std::pair<std::string, int>>& sorted) const;
+    // Profiling helpers (-profile)
+    void enableGameManagerProfiling(void* gmHandle);
+    // Time budgets (decision_timeout_ms / game_timeout_ms)
+    void applyGameLimits(void* gmHandle);
+    std::string fetchGameTimeout(size_t gi) const;
+    std::chrono::milliseconds isolatedHardLimit() const;
+    void setExitOnHang(bool on) const;
+    // Replay recording (replay_file=<file>)
+    void applyReplayOutput(void* gmHandle);
+    bool writeProfileFile(const CompetitionTally& tally) const;
+    void writeProfileContent(std::ostream& os, const CompetitionTally& tally) const;
+    void writeProfileSection(std::ostream& os, const std::string& title,
+                             const std::map<std::string, ProfileTotals>& groups) const;
 
-    // Grid normalization helpers
-    void processGridRows(const std::vector<std::string>& rawGrid, 
-                        std::vector<std::string>& normalized,
-                        size_t targetRows, size_t targetCols, 
-                        std::set<char>& invalidCharsFound) const;
-    void processExistingRow(const std::string& sourceRow, std::string& normalizedRow,
-                        size_t targetCols, std::set<char>& invalidCharsFound) const;
-    void logExtraRowsIgnored(const std::vector<std::string>& rawGrid, size_t targetRows) const;
+    // Grid warning helpers
+    void logExtraRowsIgnored(const MapGrid& grid, size_t targetRows) const;
     void logInvalidCharacters(const std::set<char>& invalidCharsFound, const std::string& path) const;
     std::string buildInvalidCharsString(const std::set<char>& invalidChars) const;
 
     // Core data
     Config config_;
-    std::unique_ptr<ThreadPool> threadPool_;
+    std::unique_ptr<ThreadPool> threadPool_;  // lives as long as the Simulator; phases end with waitIdle()
+    std::unique_ptr<MapCache>   mapCache_;    // null unless map_cache=<dir> is given
+    std::unique_ptr<CostScheduler> costScheduler_;   // null unless scheduler=cost or schedule_history=<file>
+    std::unique_ptr<CompetitionJournal> journal_;    // null unless journal=<file> or resume=<file>
+    std::string competitionFingerprint_;              // set once all competition maps are loaded
+    std::unique_ptr<ProcessPool> processPool_;        // alive only while isolated games run
+    std::unique_ptr<ResultCache> resultCache_;        // null unless result_cache=<dir> is given
+    std::uint64_t gameManagerHash_ = 0;               // plugin content hashes for the result cache
+    std::vector<std::uint64_t> algorithmHashes_;
+    bool gameManagerHashed_ = false;                  // false/0: unreadable, its games bypass the cache
+    std::vector<char> algorithmHashed_;
     
     // Statistics
     size_t totalGamesPlayed_ = 0;
     size_t loadedAlgorithms_ = 0;
     size_t loadedGameManagers_ = 0;
+    CompetitionMetrics metrics_;      // live competition counters (resumed/cached games included)
+    std::unique_ptr<MetricsReporter> metricsReporter_;   // null unless metrics_file=<file> is given
     
+    // Profiling (-profile); fetch is null when the GameManager doesn't export it
+    UserCommon_315634022::GameProfileFetchFn profileFetch_ = nullptr;
+    double cyclesPerNs_ = 1.0;
+
+    // One per gameManagerHandles_ entry; null when no limit is set or the GameManager lacks the hook
+    std::vector<UserCommon_315634022::GameTimeoutFetchFn> timeoutFetch_;
+    std::vector<UserCommon_315634022::GameLimitsFn>       limitsSet_;
+
     // Dynamic library handles
     std::vector<void*> algorithmHandles_;
     std::vector<void*> gameManagerHandles_;
@@ -190,7 +350,8 @@ private:
     // Thread safety
     mutable std::mutex resultsMutex_;
     std::vector<ComparativeEntry> comparativeResults_;
-    std::vector<CompetitionEntry> competitionResults_;
+    CompetitionTally              competitionTally_;
+    std::vector<CompetitionEntry> competitionResults_;   // only with -keep_final_boards
     
     // Utility methods
     MapData loadMapWithParams(const std::string& path) const;
@@ -207,27 +368,12 @@ private:
     
     // File writing
     bool writeComparativeFile(const std::vector<ComparativeEntry>& entries) const;
-    bool writeCompetitionFile(const std::vector<CompetitionEntry>& entries) const;
+    bool writeCompetitionFile(const CompetitionTally& tally) const;
+    void logCompetitionSummary() const;
     
     // Result formatting
     std::string outcomeMessage(int winner, GameResult::Reason reason) const;
     
-    // Map preprocessing for competition mode
-    std::vector<std::shared_ptr<SatelliteView>> preloadMaps(
-        const std::vector<std::string>& mapFiles,
-        std::vector<size_t>& mapRows,
-        std::vector<size_t>& mapCols, 
-        std::vector<size_t>& mapMaxSteps,
-        std::vector<size_t>& mapNumShells) const;
-    
-    // Enhanced map preprocessing that tracks which maps were successfully loaded
-    std::vector<std::shared_ptr<SatelliteView>> preloadMapsAndTrackValid(
-        const std::vector<std::string>& mapFiles,
-        std::vector<std::string>& validMapFiles,
-        std::vector<size_t>& mapRows,
-        std::vector<size_t>& mapCols, 
-        std::vector<size_t>& mapMaxSteps,
-        std::vector<size_t>& mapNumShells) const;
     
     // Task dispatching
     void dispatchComparativeTasks();
@@ -237,17 +383,6 @@ private:
     bool parseParameter(const std::string& line, const std::string& paramName, 
                        size_t& value, const std::string& path) const;
     
-    // Enhanced grid normalization with character cleaning and flexible dimensions
-    std::vector<std::string> cleanAndNormalizeGrid(const std::vector<std::string>& rawGrid, 
-                                                   size_t targetRows, size_t targetCols, 
-                                                   const std::string& path) const;
-    
-    // Character cleaning - only keep valid game objects, replace invalid with space
-    char cleanCharacter(char c) const;
-    
-    // Map processing helpers
-    char normalizeCell(char c) const;
-    
     // Logging helpers
     void logInfo(const std::string& component, const std::string& function, const std::string& message) const;
     void logDebug(const std::string& component, const std::string& function, const std::string& message) const;
@@ -1,6 +1,8 @@
 #include "ThreadPool.h"
 #include <iostream>
 #include <mutex>
+#include <string>
+#include <algorithm>
 
 // ——————————————————————————————————————————————————————
 // Professional Debug Logging System
@@ -38,52 +40,34 @@ static std::mutex g_debug_mutex;
         std::cerr << "[T" << std::this_thread::get_id() << "] [ERROR] [" << component << "] [" << function << "] " << message << std::endl; \
     } while(0)
 
+namespace {
+// Identifies the pool (and worker slot) the current thread belongs to, so that
+// tasks enqueued from inside a task go to the worker's own deque.
+thread_local ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_index = 0;
+
+// Injection-queue batches are capped so one worker can't hoard the backlog.
+constexpr size_t MAX_BATCH = 32;
+
+inline std::uint64_t nextRandom(std::uint64_t& s) {
+    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+    return s;
+}
+} // namespace
+
 ThreadPool::ThreadPool(size_t numThreads) {
     INFO_PRINT("THREADPOOL", "constructor", 
         "Creating ThreadPool with " + std::to_string(numThreads) + " worker threads");
-    
+
+    if (numThreads == 0) numThreads = 1;
+    workers_.reserve(numThreads);
     for (size_t i = 0; i < numThreads; ++i) {
-        workers_.emplace_back([this, i] {
-            INFO_PRINT("THREADWORKER", "worker_main", 
-                "Worker " + std::to_string(i) + " started");
-            while (true) {
-                std::function<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(mutex_);
-                    cond_.wait(lock, [this] {
-                        return stop_ || !tasks_.empty();
-                    });
-                    
-                    if (stop_ && tasks_.empty()) {
-                        DEBUG_PRINT("THREADWORKER", "worker_main", 
-                            "Worker " + std::to_string(i) + " received shutdown signal", true);
-                        break;
-                    }
-                    
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
-                    
-                    DEBUG_PRINT("THREADWORKER", "worker_main", 
-                        "Worker " + std::to_string(i) + " picked up task, " + 
-                        std::to_string(tasks_.size()) + " remaining in queue", true);
-                }
-                
-                try {
-                    task();
-                    DEBUG_PRINT("THREADWORKER", "worker_main", 
-                        "Worker " + std::to_string(i) + " completed task successfully", true);
-                } catch (const std::exception& e) {
-                    ERROR_PRINT("THREADWORKER", "worker_main", 
-                        "Worker " + std::to_string(i) + " task threw exception: " + std::string(e.what()));
-                } catch (...) {
-                    ERROR_PRINT("THREADWORKER", "worker_main", 
-                        "Worker " + std::to_string(i) + " task threw unknown exception");
-                }
-            }
-            
-            INFO_PRINT("THREADWORKER", "worker_main", 
-                "Worker " + std::to_string(i) + " exiting");
-        });
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    // Start threads only after every Worker exists: thieves index into workers_.
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers_[i]->thread = std::thread([this, i] { workerMain(i); });
     }
     
     DEBUG_PRINT("THREADPOOL", "constructor", 
@@ -95,51 +79,180 @@ ThreadPool::~ThreadPool() {
     shutdown();
 }
 
-void ThreadPool::enqueue(std::function<void()> task) {
-    size_t queue_size;
+void ThreadPool::workerMain(size_t index) {
+    INFO_PRINT("THREADWORKER", "worker_main", 
+        "Worker " + std::to_string(index) + " started");
+    tls_pool = this;
+    tls_index = index;
+
+    while (true) {
+        if (Task* task = findTask(index)) {
+            runTask(index, task);
+            continue;
+        }
+        if (stop_.load(std::memory_order_acquire) && pending_.load(std::memory_order_acquire) == 0) {
+            DEBUG_PRINT("THREADWORKER", "worker_main", 
+                "Worker " + std::to_string(index) + " received shutdown signal", true);
+            break;
+        }
+        parkUntilWork(index);
+    }
+
+    tls_pool = nullptr;
+    INFO_PRINT("THREADWORKER", "worker_main", 
+        "Worker " + std::to_string(index) + " exiting");
+}
+
+// Own deque first (LIFO, cache-warm), then the injection queue, then peers.
+ThreadPool::Task* ThreadPool::findTask(size_t index) {
+    Task* task = workers_[index]->deque.pop();
+    if (!task) task = takeInjectedBatch(index);
+    if (!task) task = stealFrom(index);
+    if (task) pending_.fetch_sub(1, std::memory_order_acq_rel);
+    return task;
+}
+
+ThreadPool::Task* ThreadPool::takeInjectedBatch(size_t index) {
+    Task* batch[MAX_BATCH];
+    size_t count = 0;
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (stop_) {
-            WARN_PRINT("THREADPOOL", "enqueue", "Attempted to enqueue task on stopped ThreadPool");
-            return;
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        if (injected_.empty()) return nullptr;
+        size_t share = injected_.size() / workers_.size();
+        count = std::clamp<size_t>(share, 1, MAX_BATCH);
+        for (size_t k = 0; k < count; ++k) {
+            batch[k] = injected_.front();
+            injected_.pop_front();
         }
-        tasks_.push(std::move(task));
-        queue_size = tasks_.size();
     }
-    
-    DEBUG_PRINT("THREADPOOL", "enqueue", 
-        "Task enqueued - queue size now: " + std::to_string(queue_size), true);
-    
-    cond_.notify_one();
+    // Run the oldest now; push the rest newest-first so pop() keeps FIFO order
+    // for the owner while thieves take from the far end.
+    auto& w = *workers_[index];
+    for (size_t k = count; k-- > 1;) w.deque.push(batch[k]);
+    w.batches.fetch_add(1, std::memory_order_relaxed);
+    return batch[0];
+}
+
+ThreadPool::Task* ThreadPool::stealFrom(size_t index) {
+    const size_t n = workers_.size();
+    if (n < 2) return nullptr;
+    auto& self = *workers_[index];
+    size_t start = static_cast<size_t>(nextRandom(self.rng) % n);
+    for (size_t k = 0; k < n; ++k) {
+        size_t victim = (start + k) % n;
+        if (victim == index) continue;
+        if (Task* task = workers_[victim]->deque.steal()) {
+            self.steals.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::runTask(size_t index, Task* raw) {
+    std::unique_ptr<Task> task(raw);
+    try {
+        (*task)();
+    } catch (const std::exception& e) {
+        ERROR_PRINT("THREADWORKER", "worker_main", 
+            "Worker " + std::to_string(index) + " task threw exception: " + std::string(e.what()));
+    } catch (...) {
+        ERROR_PRINT("THREADWORKER", "worker_main", 
+            "Worker " + std::to_string(index) + " task threw unknown exception");
+    }
+    workers_[index]->tasksRun.fetch_add(1, std::memory_order_relaxed);
+
+    // Last task out wakes waitIdle(); taking the mutex orders the notify after
+    // the waiter's predicate check.
+    if (inFlight_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        { std::lock_guard<std::mutex> lock(idleMutex_); }
+        idleCond_.notify_all();
+    }
+}
+
+// sleepers_/pending_ form a Dekker pair (both seq_cst): either the enqueuer sees
+// a sleeper and notifies under the mutex, or the sleeper sees the new task.
+void ThreadPool::parkUntilWork(size_t index) {
+    auto start = std::chrono::steady_clock::now();
+    workers_[index]->parkedSince.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count(),
+        std::memory_order_relaxed);
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        sleepCond_.wait(lock, [this] {
+            return stop_.load(std::memory_order_seq_cst) ||
+                   pending_.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    auto idle = std::chrono::steady_clock::now() - start;
+    workers_[index]->idleNanos.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(idle).count(),
+        std::memory_order_relaxed);
+    workers_[index]->parkedSince.store(0, std::memory_order_relaxed);
+}
+
+void ThreadPool::notifyWorkAvailable() {
+    if (sleepers_.load(std::memory_order_seq_cst) == 0) return;
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    sleepCond_.notify_one();
+}
+
+void ThreadPool::enqueue(Task task) {
+    const bool fromWorker = (tls_pool == this);
+    // Workers may keep submitting while the pool drains; outsiders may not.
+    if (stop_.load(std::memory_order_acquire) && !fromWorker) {
+        WARN_PRINT("THREADPOOL", "enqueue", "Attempted to enqueue task on stopped ThreadPool");
+        return;
+    }
+
+    inFlight_.fetch_add(1, std::memory_order_acq_rel);
+    auto* item = new Task(std::move(task));
+    if (fromWorker) {
+        workers_[tls_index]->deque.push(item);
+    } else {
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        injected_.push_back(item);
+    }
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    notifyWorkAvailable();
+}
+
+void ThreadPool::waitIdle() {
+    if (tls_pool == this) {
+        ERROR_PRINT("THREADPOOL", "waitIdle", "waitIdle called from a worker thread; ignoring");
+        return;
+    }
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    idleCond_.wait(lock, [this] {
+        return inFlight_.load(std::memory_order_acquire) == 0;
+    });
 }
 
 void ThreadPool::shutdown() {
     DEBUG_PRINT("THREADPOOL", "shutdown", "Initiating ThreadPool shutdown", true);
 
-    size_t pending_tasks;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (stop_) {
-            DEBUG_PRINT("THREADPOOL", "shutdown", "ThreadPool already stopped", true);
-            return;
-        }
-        pending_tasks = tasks_.size();
-        stop_ = true;
+    if (stop_.exchange(true, std::memory_order_acq_rel)) {
+        DEBUG_PRINT("THREADPOOL", "shutdown", "ThreadPool already stopped", true);
+        return;
     }
-    
+
+    size_t pending_tasks = pending_.load(std::memory_order_acquire);
     if (pending_tasks > 0) {
         INFO_PRINT("THREADPOOL", "shutdown", 
             "Shutting down with " + std::to_string(pending_tasks) + " pending tasks");
     }
     
     DEBUG_PRINT("THREADPOOL", "shutdown", "Notifying all workers to stop", true);
-    cond_.notify_all();
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    sleepCond_.notify_all();
     
     INFO_PRINT("THREADPOOL", "shutdown", 
         "Waiting for " + std::to_string(workers_.size()) + " workers to join");
     
     for (size_t i = 0; i < workers_.size(); ++i) {
-        auto& w = workers_[i];
+        auto& w = workers_[i]->thread;
         if (w.joinable()) {
             DEBUG_PRINT("THREADPOOL", "shutdown", 
                 "Joining worker " + std::to_string(i), true);
@@ -149,6 +262,39 @@ void ThreadPool::shutdown() {
         }
     }
     
+    logStats();
     INFO_PRINT("THREADPOOL", "shutdown", "ThreadPool shutdown completed");
 }
 
+std::vector<ThreadPool::WorkerStats> ThreadPool::stats() const {
+    std::vector<WorkerStats> out;
+    out.reserve(workers_.size());
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    for (const auto& w : workers_) {
+        WorkerStats s;
+        s.tasksRun = w->tasksRun.load(std::memory_order_relaxed);
+        s.steals   = w->steals.load(std::memory_order_relaxed);
+        s.batches  = w->batches.load(std::memory_order_relaxed);
+        s.idle     = std::chrono::nanoseconds(w->idleNanos.load(std::memory_order_relaxed));
+        const std::int64_t parked = w->parkedSince.load(std::memory_order_relaxed);
+        if (parked != 0) {
+            s.idle += std::chrono::duration_cast<std::chrono::nanoseconds>(now) - std::chrono::nanoseconds(parked);
+        }
+        out.push_back(s);
+    }
+    return out;
+}
+
+void ThreadPool::logStats() const {
+    auto all = stats();
+    for (size_t i = 0; i < all.size(); ++i) {
+        const auto& s = all[i];
+        INFO_PRINT("THREADPOOL", "stats",
+            "Worker " + std::to_string(i) +
+            ": tasks=" + std::to_string(s.tasksRun) +
+            ", steals=" + std::to_string(s.steals) +
+            ", batches=" + std::to_string(s.batches) +
+            ", idle_ms=" + std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(s.idle).count()));
+    }
+}
@@ -1,29 +1,92 @@
 #pragma once
 #include <vector>
+#include <deque>
 #include <thread>
-#include <queue>
 #include <functional>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include "WorkStealingDeque.h"
 
 
-// A fixed‐size thread‐pool. Enqueue tasks; they’ll run on worker threads.
+// A fixed‐size work‐stealing thread‐pool. Enqueue tasks; they’ll run on worker threads.
+// Each worker owns a lock‐free deque. Tasks enqueued from outside the pool go to a
+// shared injection queue that idle workers drain in batches; tasks enqueued from
+// inside a task go straight to the calling worker's deque. Idle workers steal.
 class ThreadPool {
 public:
+    using Task = std::function<void()>;
+
+    // Snapshot of one worker's counters
+    struct WorkerStats {
+        std::size_t tasksRun = 0;
+        std::size_t steals = 0;
+        std::size_t batches = 0;          // injection-queue batches taken
+        std::chrono::nanoseconds idle{0}; // time spent parked waiting for work, including right now
+    };
+
     explicit ThreadPool(size_t numThreads);
     ~ThreadPool();
 
     // Add a task to be run by the pool
-    void enqueue(std::function<void()> task);
+    void enqueue(Task task);
+
+    // Block until every task enqueued so far (and any tasks they enqueue) has
+    // finished. Workers stay alive, so the pool can be reused afterwards.
+    // Must not be called from a pool thread.
+    void waitIdle();
 
     // Stop accepting new tasks, finish all pending, and join threads
     void shutdown();
 
+    // Number of worker threads
+    size_t size() const { return workers_.size(); }
+
+    // Per-worker counters; safe to call while the pool is running
+    std::vector<WorkerStats> stats() const;
+
+    // Tasks enqueued but not yet picked up by a worker
+    size_t queueDepth() const { return pending_.load(std::memory_order_relaxed); }
+
 private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex mutex_;
-    std::condition_variable cond_;
-    bool stop_ = false;
-};
+    struct Worker {
+        std::thread thread;
+        WorkStealingDeque<Task> deque;
+        std::atomic<std::size_t> tasksRun{0};
+        std::atomic<std::size_t> steals{0};
+        std::atomic<std::size_t> batches{0};
+        std::atomic<std::int64_t> idleNanos{0};
+        std::atomic<std::int64_t> parkedSince{0};   // steady-clock ns of the current park, 0 = awake
+        std::uint64_t rng = 0;            // victim selection, owner only
+    };
 
+    void workerMain(size_t index);
+    Task* findTask(size_t index);
+    Task* takeInjectedBatch(size_t index);
+    Task* stealFrom(size_t index);
+    void runTask(size_t index, Task* task);
+    void parkUntilWork(size_t index);
+    void notifyWorkAvailable();
+    void logStats() const;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Injection queue for tasks submitted from non-worker threads
+    std::mutex injectMutex_;
+    std::deque<Task*> injected_;
+
+    // Parking
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCond_;
+    std::atomic<std::size_t> sleepers_{0};
+
+    // Idle barrier
+    std::mutex idleMutex_;
+    std::condition_variable idleCond_;
+
+    std::atomic<std::size_t> pending_{0};   // enqueued but not yet picked up
+    std::atomic<std::size_t> inFlight_{0};  // enqueued but not yet finished
+    std::atomic<bool> stop_{false};
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13).
+// The owning worker pushes and pops at the bottom without locks; any other
+// thread may steal from the top. Elements are raw pointers whose lifetime is
+// managed by the caller. Buffers retired by grow() are kept until the deque
+// is destroyed, since a concurrent thief may still be reading them.
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t initialCapacity = 64)
+        : top_(0), bottom_(0) {
+        std::size_t cap = 1;
+        while (cap < initialCapacity) cap <<= 1;
+        buffers_.push_back(std::make_unique<Buffer>(cap));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    void push(T* item) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        Buffer* buf = buffer_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(buf->capacity) - 1) {
+            buf = grow(buf, t, b);
+        }
+        buf->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. Returns nullptr when empty.
+    T* pop() {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = buf->get(b);
+        if (t == b) {
+            // Last element: race against thieves for it.
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread. Returns nullptr when empty or when another thread won the race.
+    T* steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+
+        Buffer* buf = buffer_.load(std::memory_order_acquire);
+        T* item = buf->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // Approximate; only meaningful as a hint.
+    std::size_t sizeHint() const {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+private:
+    struct Buffer {
+        std::size_t capacity;
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+
+        explicit Buffer(std::size_t cap)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T*>[cap]) {}
+
+        T* get(std::int64_t i) const {
+            return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t i, T* item) {
+            slots[static_cast<std::size_t>(i) & mask].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    Buffer* grow(Buffer* old, std::int64_t t, std::int64_t b) {
+        auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+        for (std::int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        Buffer* raw = bigger.get();
+        buffers_.push_back(std::move(bigger));
+        buffer_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top_;
+    alignas(64) std::atomic<std::int64_t> bottom_;
+    alignas(64) std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;  // owner only
+};
@@ -0,0 +1,39 @@
+// UserCommon/GameLimits.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace UserCommon_315634022 {
+
+/// Time budgets a GameManager enforces per game; 0 means unlimited.
+///   decisionMs  one getAction()/updateTankWithBattleInfo() call. A tank
+///               whose call overruns is forfeited (removed from the board).
+///   gameMs      the whole game. When it runs out, the player whose
+///               algorithms used more of it forfeits all its tanks.
+/// Both end in an ordinary GameResult (the other side wins by
+/// ALL_TANKS_DEAD); the GameManager reports what happened through
+/// kGameTimeoutFetchSymbol.
+///   exitOnHang  nonzero when the process only runs games and is replaced
+///               if it dies (isolation=process): a call still running long
+///               past its decision deadline then ends the process with
+///               kHangExitStatus instead of blocking it forever.
+struct GameLimits {
+    std::uint64_t decisionMs = 0;
+    std::uint64_t gameMs     = 0;
+    std::uint64_t exitOnHang = 0;
+};
+
+/// Exit status of a game process ended by exitOnHang.
+inline constexpr int kHangExitStatus = 124;
+
+/// Optional C entry points, looked up with dlsym() like the profiling ones.
+///   void <kGameLimitsSymbol>(const GameLimits* limits);        // process-wide
+///   int  <kGameTimeoutFetchSymbol>(char* buf, size_t size);    // last game on this thread:
+///                                                              // 1 and a description if it timed out
+inline constexpr const char* kGameLimitsSymbol       = "GameManager_setLimits";
+inline constexpr const char* kGameTimeoutFetchSymbol = "GameManager_lastGameTimeout";
+using GameLimitsFn       = void (*)(const GameLimits*);
+using GameTimeoutFetchFn = int (*)(char*, std::size_t);
+
+} // namespace UserCommon_315634022
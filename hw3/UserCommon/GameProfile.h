@@ -0,0 +1,64 @@
+// ===================== GameProfile.h =====================
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace UserCommon_315634022 {
+
+/// Cheap monotonic cycle counter: rdtsc on x86, steady_clock ns elsewhere.
+inline std::uint64_t readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// Measures readCycles() ticks per nanosecond against steady_clock (~10ms).
+inline double calibrateCyclesPerNs() {
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    const std::uint64_t c0 = readCycles();
+    while (clock::now() - t0 < std::chrono::milliseconds(10)) {}
+    const std::uint64_t c1 = readCycles();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count();
+    return ns > 0 ? double(c1 - c0) / double(ns) : 1.0;
+}
+
+/// Per-game cycle counts collected by the GameManager when profiling is on.
+/// Plain data so it can cross the GameManager .so boundary unchanged.
+struct GameProfile {
+    /// One slot per step of a turn: gathering actions, then the fixed
+    /// phases of GameState::executePhases() in execution order.
+    static constexpr std::size_t kPhaseCount = 12;
+    static constexpr const char* kPhaseNames[kPhaseCount] = {
+        "gather",          "rotations",       "mine_hits",   "cooldowns",
+        "backward_moves",  "shell_moves",     "shell_hits",  "shooting",
+        "tank_moves",      "shell_filter",    "cleanup",     "end_check"
+    };
+
+    std::uint64_t phaseCycles[kPhaseCount] = {};
+    std::uint64_t algoCycles[2] = {};   // per player: getAction + updateTankWithBattleInfo
+    std::uint64_t algoCalls[2]  = {};
+    std::uint64_t turns = 0;
+
+    void clear() { *this = GameProfile{}; }
+};
+
+/// Optional C entry points exported by a GameManager .so that supports
+/// profiling. The Simulator looks them up with dlsym(); a GameManager
+/// without them simply isn't profiled.
+///   void <kGameProfileEnableSymbol>(int enabled);            // process-wide switch
+///   int  <kGameProfileFetchSymbol>(GameProfile* out);        // last game on this thread, 1 if any
+inline constexpr const char* kGameProfileEnableSymbol = "GameManager_setProfiling";
+inline constexpr const char* kGameProfileFetchSymbol  = "GameManager_lastGameProfile";
+using GameProfileEnableFn = void (*)(int);
+using GameProfileFetchFn  = int (*)(GameProfile*);
+
+} // namespace UserCommon_315634022
@@ -0,0 +1,16 @@
+// UserCommon/GameReplay.h
+#pragma once
+
+namespace UserCommon_315634022 {
+
+/// Optional C entry point, looked up with dlsym() like the profiling ones.
+///   int <kGameReplaySymbol>(const char* path);    // process-wide, 1 on success
+/// Once set, every game that would write a text log (verbose runs) appends
+/// one compact binary record to this file instead (see the GameManager's
+/// Replay.h; its `make replay` tool lists records and converts them back to
+/// the text logs). The file is opened O_APPEND, so threads and forked
+/// worker processes share it.
+inline constexpr const char* kGameReplaySymbol = "GameManager_setReplayFile";
+using GameReplayFn = int (*)(const char*);
+
+} // namespace UserCommon_315634022